@@ -28,6 +28,7 @@
 #include <string>
 
 #include "sidplayfp/SidInfo.h"
+#include "sidplayfp/SidConfig.h"
 
 #include "mixer.h"
 
@@ -62,10 +63,15 @@ public:
     std::string m_basicDesc;
     std::string m_chargenDesc;
 
+    /// Content hashes of the kernal, basic and chargen ROMs, 0 if not set
+    uint_least64_t m_romDigests[3];
+
     const unsigned int m_maxsids;
 
     unsigned int m_channels;
 
+    double m_sampleRate;
+
     uint_least16_t m_driverAddr;
     uint_least16_t m_driverLength;
 
@@ -82,10 +88,13 @@ public:
         m_version(PACKAGE_VERSION),
         m_maxsids(libsidplayfp::Mixer::MAX_SIDS),
         m_channels(1),
+        m_sampleRate(SidConfig::DEFAULT_SAMPLING_FREQ),
         m_driverAddr(0),
         m_driverLength(0),
         m_powerOnDelay(0)
     {
+        m_romDigests[0] = m_romDigests[1] = m_romDigests[2] = 0;
+
         m_credits.push_back(PACKAGE_NAME " V" PACKAGE_VERSION " Engine:\n"
             "\tCopyright (C) 2000 Simon White\n"
             "\tCopyright (C) 2007-2010 Antti Lankila\n"
@@ -103,6 +112,8 @@ public:
 
     unsigned int getChannels() const override { return m_channels; }
 
+    double getSampleRate() const override { return m_sampleRate; }
+
     uint_least16_t getDriverAddr() const override { return m_driverAddr; }
     uint_least16_t getDriverLength() const override { return m_driverLength; }
 
@@ -113,6 +124,21 @@ public:
     const char *getKernalDesc() const override { return m_kernalDesc.c_str(); }
     const char *getBasicDesc() const override { return m_basicDesc.c_str(); }
     const char *getChargenDesc() const override { return m_chargenDesc.c_str(); }
+
+    uint_least64_t getRomDigest() const override
+    {
+        // 64 bit FNV-1a over the three hashes
+        uint_least64_t hash = 0xcbf29ce484222325ULL;
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 64; j += 8)
+            {
+                hash ^= (m_romDigests[i] >> j) & 0xff;
+                hash *= 0x100000001b3ULL;
+            }
+        }
+        return hash;
+    }
 };
 
 #endif  /* SIDTUNEINFOIMPL_H */
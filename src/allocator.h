@@ -0,0 +1,157 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+#include "sidplayfp/SidAllocator.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Base for the objects which can be placed with a SidAllocator,
+ * using `new (allocator) T(...)`.
+ *
+ * The allocator is stored in front of every block, so the objects
+ * are deleted as usual, also through smart pointers,
+ * and a null allocator falls back to the heap.
+ */
+class allocated
+{
+private:
+    union header_t
+    {
+        const SidAllocator *allocator;
+
+        // force the maximum alignment
+        long double ld;
+        void *p;
+    };
+
+public:
+    /**
+     * Allocate a block.
+     *
+     * @param size the number of bytes
+     * @param allocator the allocator, nullptr for the heap
+     * @throw std::bad_alloc
+     */
+    static void* allocate(size_t size, const SidAllocator *allocator)
+    {
+        header_t *block;
+        if (allocator != nullptr)
+        {
+            block = static_cast<header_t*>(allocator->allocate(sizeof(header_t) + size, allocator->context));
+            if (block == nullptr)
+                throw std::bad_alloc();
+        }
+        else
+        {
+            block = static_cast<header_t*>(::operator new(sizeof(header_t) + size));
+        }
+
+        block->allocator = allocator;
+        return block + 1;
+    }
+
+    /**
+     * Release a block obtained from #allocate.
+     */
+    static void release(void *ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        header_t *block = static_cast<header_t*>(ptr) - 1;
+        const SidAllocator *allocator = block->allocator;
+        if (allocator != nullptr)
+            allocator->release(block, allocator->context);
+        else
+            ::operator delete(block);
+    }
+
+    static void* operator new(size_t size, const SidAllocator *allocator) { return allocate(size, allocator); }
+    static void* operator new(size_t size) { return allocate(size, nullptr); }
+
+    static void operator delete(void *ptr, const SidAllocator*) { release(ptr); }
+    static void operator delete(void *ptr) { release(ptr); }
+};
+
+/**
+ * Standard library allocator drawing from a SidAllocator.
+ */
+template<typename T>
+class stlAllocator
+{
+    template<typename U> friend class stlAllocator;
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template<typename U> struct rebind { typedef stlAllocator<U> other; };
+
+private:
+    const SidAllocator *m_allocator;
+
+public:
+    explicit stlAllocator(const SidAllocator *allocator = nullptr) :
+        m_allocator(allocator) {}
+
+    template<typename U>
+    stlAllocator(const stlAllocator<U> &other) :
+        m_allocator(other.m_allocator) {}
+
+    pointer allocate(size_type n, const void* = nullptr)
+    {
+        return static_cast<pointer>(allocated::allocate(n * sizeof(T), m_allocator));
+    }
+
+    void deallocate(pointer p, size_type) { allocated::release(p); }
+
+    size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    void construct(pointer p, const T &value) { new (static_cast<void*>(p)) T(value); }
+    void destroy(pointer p) { p->~T(); }
+
+    template<typename U>
+    bool operator==(const stlAllocator<U> &other) const { return m_allocator == other.m_allocator; }
+
+    template<typename U>
+    bool operator!=(const stlAllocator<U> &other) const { return m_allocator != other.m_allocator; }
+};
+
+}
+
+#endif // ALLOCATOR_H
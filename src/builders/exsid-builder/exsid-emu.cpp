@@ -145,6 +145,49 @@ void exSID::write(uint_least8_t addr, uint8_t data)
     exSID_clkdwrite(exsid, cycles, addr, data);
 }
 
+bool exSID::batch(const SidWrite* writes, unsigned int n, unsigned int &done)
+{
+    // Delay carried over the skipped writes
+    event_clock_t cycles = 0;
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const SidWrite &w = writes[i];
+        m_accessClk += w.cycles;
+        cycles += w.cycles;
+
+        busValue = w.data;
+
+        if (w.addr > 0x18)
+            continue;
+
+        while (cycles > 0xffff)
+        {
+            exSID_delay(exsid, 0xffff);
+            cycles -= 0xffff;
+        }
+
+        uint8_t data = w.data;
+        if (w.addr % 7 == 4 && muted[w.addr / 7])
+            data = 0;
+
+        exSID_clkdwrite(exsid, static_cast<unsigned int>(cycles), w.addr, data);
+        cycles = 0;
+    }
+
+    while (cycles > 0xffff)
+    {
+        exSID_delay(exsid, 0xffff);
+        cycles -= 0xffff;
+    }
+
+    if (cycles)
+        exSID_delay(exsid, static_cast<unsigned int>(cycles));
+
+    done = n;
+    return true;
+}
+
 void exSID::voice(unsigned int num, bool mute)
 {
     muted[num] = mute;
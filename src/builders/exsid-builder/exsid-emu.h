@@ -55,6 +55,9 @@ private:
 private:
     unsigned int delay();
 
+protected:
+    bool batch(const SidWrite* writes, unsigned int n, unsigned int &done) override;
+
 public:
     static const char* getCredits();
 
@@ -77,6 +80,8 @@ public:
 
     void voice(unsigned int num, bool mute) override;
 
+    size_t memoryUsage() const override { return sizeof(exSID); }
+
     void filter(bool) {}
 
     void sampling(float systemclock, float freq,
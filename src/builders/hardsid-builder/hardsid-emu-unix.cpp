@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef HAVE_CONFIG_H
 #  include "config.h"
@@ -179,6 +180,49 @@ void HardSID::write(uint_least8_t addr, uint8_t data)
     ::write(m_handle, &packet, sizeof(packet));
 }
 
+bool HardSID::batch(const SidWrite* writes, unsigned int n, unsigned int &done)
+{
+    // No buffer to fill, everything is sent at once
+    done = n;
+
+    if (!m_handle)
+        return true;
+
+    // Send all the writes with a single system call
+    std::vector<unsigned int> packets;
+    packets.reserve(n);
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const SidWrite &w = writes[i];
+        event_clock_t cycles = w.cycles;
+        m_accessClk += cycles;
+
+        if (cycles > 0xffff)
+        {
+            if (!packets.empty())
+            {
+                ::write(m_handle, &packets[0], packets.size() * sizeof(unsigned int));
+                packets.clear();
+            }
+
+            while (cycles > 0xffff)
+            {
+                ioctl(m_handle, HSID_IOCTL_DELAY, 0xffff);
+                cycles -= 0xffff;
+            }
+        }
+
+        packets.push_back(((cycles & 0xffff) << 16) | ((w.addr & 0x1f) << 8)
+            | (w.data & 0xff));
+    }
+
+    if (!packets.empty())
+        ::write(m_handle, &packets[0], packets.size() * sizeof(unsigned int));
+
+    return true;
+}
+
 void HardSID::voice(unsigned int num, bool mute)
 {
     // Only have 3 voices!
@@ -107,6 +107,28 @@ void HardSID::write(uint_least8_t addr, uint8_t data)
     hsid2.Write((BYTE) m_instance, (WORD) cycles, (BYTE) addr, (BYTE) data);
 }
 
+bool HardSID::batch(const SidWrite* writes, unsigned int n, unsigned int &done)
+{
+    done = n;
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const SidWrite &w = writes[i];
+        event_clock_t cycles = w.cycles;
+        m_accessClk += cycles;
+
+        while (cycles > 0xFFFF)
+        {
+            hsid2.Delay((BYTE) m_instance, 0xFFFF);
+            cycles -= 0xFFFF;
+        }
+
+        hsid2.Write((BYTE) m_instance, (WORD) cycles, (BYTE) (w.addr & 0x1f), (BYTE) w.data);
+    }
+
+    return true;
+}
+
 void HardSID::reset(uint8_t volume)
 {
     m_accessClk = 0;
@@ -125,6 +125,9 @@ private:
 private:
     event_clock_t delay();
 
+protected:
+    bool batch(const SidWrite* writes, unsigned int n, unsigned int &done) override;
+
 public:
     static const char* getCredits();
 
@@ -147,6 +150,8 @@ public:
 
     void voice(unsigned int num, bool mute) override;
 
+    size_t memoryUsage() const override { return sizeof(HardSID); }
+
     // HardSID specific
     void flush();
     void filter(bool enable);
@@ -26,6 +26,7 @@
 #include <new>
 
 #include "resid-emu.h"
+#include "fnvhash.h"
 
 ReSIDBuilder::~ReSIDBuilder()
 {   // Remove all SID emulations
@@ -47,7 +48,7 @@ unsigned int ReSIDBuilder::create(unsigned int sids)
     {
         try
         {
-            sidobjs.insert(new libsidplayfp::ReSID(this));
+            sidobjs.insert(new (allocator()) libsidplayfp::ReSID(this));
         }
         // Memory alloc failed?
         catch (std::bad_alloc const &)
@@ -67,10 +68,20 @@ const char *ReSIDBuilder::credits() const
 
 void ReSIDBuilder::filter(bool enable)
 {
+    m_filter = enable;
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSID, bool>(&libsidplayfp::ReSID::filter, enable));
 }
 
 void ReSIDBuilder::bias(double dac_bias)
 {
+    m_bias = dac_bias;
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSID, double>(&libsidplayfp::ReSID::bias, dac_bias));
 }
+
+uint_least64_t ReSIDBuilder::settingsHash() const
+{
+    libsidplayfp::fnvHash h;
+    h.add(m_filter);
+    h.addDouble(m_bias);
+    return h.get();
+}
@@ -53,17 +53,18 @@ const char* ReSID::getCredits()
 
 ReSID::ReSID(sidbuilder *builder) :
     sidemu(builder),
-    m_sid(*(new reSID::SID)),
+    // reSID is not aware of the allocator, place the chip with placement new
+    m_sid(*(new (allocate(sizeof(reSID::SID), builder->allocator())) reSID::SID)),
     m_voiceMask(0x07)
 {
-    m_buffer = new short[OUTPUTBUFFERSIZE];
+    m_buffer = m_output;
     reset(0);
 }
 
 ReSID::~ReSID()
 {
-    delete &m_sid;
-    delete[] m_buffer;
+    m_sid.~SID();
+    release(&m_sid);
 }
 
 void ReSID::bias(double dac_bias)
@@ -75,6 +76,7 @@ void ReSID::bias(double dac_bias)
 void ReSID::reset(uint8_t volume)
 {
     m_accessClk = 0;
+    m_batchCycles = 0;
     m_sid.reset();
     m_sid.write(0x18, volume);
 }
@@ -91,6 +93,31 @@ void ReSID::write(uint_least8_t addr, uint8_t data)
     m_sid.write(addr, data);
 }
 
+bool ReSID::batch(const SidWrite* writes, unsigned int n, unsigned int &done)
+{
+    for (; done < n; done++)
+    {
+        const SidWrite &w = writes[done];
+
+        // reSID stops when the buffer is full, leaving the rest in cycles
+        reSID::cycle_count cycles = w.cycles - m_batchCycles;
+        const reSID::cycle_count pending = cycles;
+        m_bufferpos += m_sid.clock(cycles, (short *) m_buffer + m_bufferpos, OUTPUTBUFFERSIZE - m_bufferpos, 1);
+        m_accessClk += pending - cycles;
+
+        if (cycles > 0)
+        {
+            m_batchCycles += pending - cycles;
+            return true;
+        }
+
+        m_batchCycles = 0;
+        m_sid.write(w.addr & 0x1f, w.data);
+    }
+
+    return true;
+}
+
 void ReSID::clock()
 {
     reSID::cycle_count cycles = eventScheduler->getTime(EVENT_CLOCK_PHI1) - m_accessClk;
@@ -46,6 +46,12 @@ private:
     reSID::SID   &m_sid;
     uint8_t       m_voiceMask;
 
+    /// Output buffer, kept with the emulation state
+    short         m_output[OUTPUTBUFFERSIZE];
+
+protected:
+    bool batch(const SidWrite* writes, unsigned int n, unsigned int &done) override;
+
 public:
     static const char* getCredits();
 
@@ -71,6 +77,11 @@ public:
 
     void model(SidConfig::sid_model_t model, bool digiboost) override;
 
+    size_t memoryUsage() const override
+    {
+        return sizeof(ReSID) + sizeof(reSID::SID);
+    }
+
     // Specific to resid
     void bias(double dac_bias);
     void filter(bool enable);
@@ -31,9 +31,23 @@
  */
 class SID_EXTERN ReSIDBuilder : public sidbuilder
 {
+private:
+    /// @name settings last applied, for #settingsHash
+    //@{
+    bool m_filter;
+    double m_bias;
+    //@}
+
 public:
-    ReSIDBuilder(const char * const name) :
-        sidbuilder(name) {}
+    /**
+     * @param name the builder name
+     * @param allocator where to place the emulations, see SidAllocator.
+     *                  0 for the heap. @since 2.7
+     */
+    ReSIDBuilder(const char * const name, const SidAllocator *allocator = 0) :
+        sidbuilder(name, allocator),
+        m_filter(true),
+        m_bias(0.) {}
     ~ReSIDBuilder();
 
     /**
@@ -61,6 +75,8 @@ public:
      */
     void bias(double dac_bias);
     //@}
+
+    uint_least64_t settingsHash() const;
 };
 
 #endif // RESID_H
@@ -26,6 +26,7 @@
 #include <new>
 
 #include "residfp-emu.h"
+#include "fnvhash.h"
 
 ReSIDfpBuilder::~ReSIDfpBuilder()
 {   // Remove all SID emulations
@@ -47,7 +48,7 @@ unsigned int ReSIDfpBuilder::create(unsigned int sids)
     {
         try
         {
-            sidobjs.insert(new libsidplayfp::ReSIDfp(this));
+            sidobjs.insert(new (allocator()) libsidplayfp::ReSIDfp(this));
         }
         // Memory alloc failed?
         catch (std::bad_alloc const &)
@@ -68,15 +69,27 @@ const char *ReSIDfpBuilder::credits() const
 
 void ReSIDfpBuilder::filter(bool enable)
 {
+    m_filter = enable;
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSIDfp, bool>(&libsidplayfp::ReSIDfp::filter, enable));
 }
 
 void ReSIDfpBuilder::filter6581Curve(double filterCurve)
 {
+    m_filter6581Curve = filterCurve;
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSIDfp, double>(&libsidplayfp::ReSIDfp::filter6581Curve, filterCurve));
 }
 
 void ReSIDfpBuilder::filter8580Curve(double filterCurve)
 {
+    m_filter8580Curve = filterCurve;
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSIDfp, double>(&libsidplayfp::ReSIDfp::filter8580Curve, filterCurve));
 }
+
+uint_least64_t ReSIDfpBuilder::settingsHash() const
+{
+    libsidplayfp::fnvHash h;
+    h.add(m_filter);
+    h.addDouble(m_filter6581Curve);
+    h.addDouble(m_filter8580Curve);
+    return h.get();
+}
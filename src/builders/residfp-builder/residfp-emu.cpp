@@ -27,7 +27,9 @@
 #include <algorithm>
 
 #include "residfp/siddefs-fp.h"
+#include "residfp/OutputStage.h"
 #include "sidplayfp/siddefs.h"
+#include "sidplayfp/sidbuilder.h"
 
 #ifdef HAVE_CONFIG_H
 #  include "config.h"
@@ -36,6 +38,140 @@
 namespace libsidplayfp
 {
 
+/**
+ * A group of chips mixed at clock rate into shared output stages.
+ * Placed with the chips' allocator.
+ */
+class ReSIDfpGroup : public allocated
+{
+public:
+    typedef std::vector<ReSIDfp*, stlAllocator<ReSIDfp*> > chips_t;
+
+private:
+    /// Cycles mixed per step
+    static const unsigned int CHUNK_SIZE = 1024;
+
+private:
+    /// Where the output stages place their resamplers
+    ReSIDfpAllocator m_allocator;
+
+    chips_t m_chips;
+
+    /// Mixing weights, one row per channel
+    std::vector<uint_least32_t, stlAllocator<uint_least32_t> > m_matrix;
+
+    /// Chip outputs for the current step
+    std::vector<unsigned short, stlAllocator<unsigned short> > m_chipOutput;
+
+    reSIDfp::OutputStage m_stages[2];
+
+    unsigned int m_channels;
+
+public:
+    ReSIDfpGroup(const std::vector<ReSIDfp*>& chips,
+        const std::vector<int_least32_t>& matrix, unsigned int channels,
+        const SidAllocator *allocator) :
+        m_allocator(allocator),
+        m_chips(chips.begin(), chips.end(), stlAllocator<ReSIDfp*>(allocator)),
+        m_matrix(matrix.begin(), matrix.end(), stlAllocator<uint_least32_t>(allocator)),
+        m_chipOutput(CHUNK_SIZE * chips.size(), 0, stlAllocator<unsigned short>(allocator)),
+        m_channels(channels) {}
+
+    const chips_t& chips() const { return m_chips; }
+
+    size_t memoryUsage() const
+    {
+        size_t size = sizeof(ReSIDfpGroup)
+            + m_chips.capacity() * sizeof(ReSIDfp*)
+            + m_matrix.capacity() * sizeof(uint_least32_t)
+            + m_chipOutput.capacity() * sizeof(unsigned short);
+
+        for (unsigned int ch = 0; ch < m_channels; ch++)
+        {
+            // the stages themselves are part of the group
+            size += m_stages[ch].getMemoryUsage() - sizeof(reSIDfp::OutputStage);
+        }
+
+        return size;
+    }
+
+    void setSamplingParameters(double clockFrequency, reSIDfp::SamplingMethod method,
+        double samplingFrequency, double highestAccurateFrequency)
+    {
+        for (unsigned int ch = 0; ch < m_channels; ch++)
+        {
+            m_stages[ch].setSamplingParameters(clockFrequency, method, samplingFrequency, highestAccurateFrequency, &m_allocator);
+        }
+    }
+
+    void reset()
+    {
+        for (unsigned int ch = 0; ch < m_channels; ch++)
+        {
+            m_stages[ch].reset();
+        }
+    }
+
+    /**
+     * Clock all the chips to the present moment.
+     * The output channels are written to the first chips' buffers.
+     */
+    void clock(event_clock_t now);
+};
+
+void ReSIDfpGroup::clock(event_clock_t now)
+{
+    const unsigned int chips = m_chips.size();
+
+    event_clock_t cycles = now - m_chips[0]->m_accessClk;
+    int pos = m_chips[0]->m_bufferpos;
+
+    while (cycles > 0)
+    {
+        const unsigned int n = std::min(cycles, static_cast<event_clock_t>(CHUNK_SIZE));
+
+        for (unsigned int c = 0; c < chips; c++)
+        {
+            m_chips[c]->m_sid.clockChipOutput(n, &m_chipOutput[c * CHUNK_SIZE]);
+        }
+
+        for (unsigned int i = 0; i < n; i++)
+        {
+            bool ready = false;
+            for (unsigned int ch = 0; ch < m_channels; ch++)
+            {
+                // weights add up to 1 << 16 so the sum can't overflow
+                const uint_least32_t *weights = &m_matrix[ch * chips];
+                uint_least32_t sum = 0;
+                for (unsigned int c = 0; c < chips; c++)
+                {
+                    sum += weights[c] * m_chipOutput[c * CHUNK_SIZE + i];
+                }
+                ready = m_stages[ch].input(sum >> 16);
+            }
+
+            if (ready)
+            {
+                for (unsigned int ch = 0; ch < m_channels; ch++)
+                {
+                    m_chips[ch]->m_buffer[pos] = m_stages[ch].getOutput();
+                }
+                pos++;
+            }
+        }
+
+        cycles -= n;
+    }
+
+    for (unsigned int c = 0; c < chips; c++)
+    {
+        m_chips[c]->m_accessClk = now;
+        m_chips[c]->m_bufferpos = pos;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 const char* ReSIDfp::getCredits()
 {
     return
@@ -49,16 +185,22 @@ const char* ReSIDfp::getCredits()
 
 ReSIDfp::ReSIDfp(sidbuilder *builder) :
     sidemu(builder),
-    m_sid(*(new reSIDfp::SID))
+    m_allocator(builder->allocator()),
+    m_sid(*(new (&m_allocator) reSIDfp::SID(&m_allocator))),
+    m_group(nullptr),
+    m_systemClock(0.),
+    m_samplingFreq(0.),
+    m_highestAccurateFreq(0.),
+    m_samplingMethod(reSIDfp::RESAMPLE)
 {
-    m_buffer = new short[OUTPUTBUFFERSIZE];
+    m_buffer = m_output;
     reset(0);
 }
 
 ReSIDfp::~ReSIDfp()
 {
+    ungroup();
     delete &m_sid;
-    delete[] m_buffer;
 }
 
 void ReSIDfp::filter6581Curve(double filterCurve)
@@ -75,8 +217,12 @@ void ReSIDfp::filter8580Curve(double filterCurve)
 void ReSIDfp::reset(uint8_t volume)
 {
     m_accessClk = 0;
+    m_batchCycles = 0;
     m_sid.reset();
     m_sid.write(0x18, volume);
+
+    if (m_group != nullptr)
+        m_group->reset();
 }
 
 uint8_t ReSIDfp::read(uint_least8_t addr)
@@ -91,13 +237,65 @@ void ReSIDfp::write(uint_least8_t addr, uint8_t data)
     m_sid.write(addr, data);
 }
 
+bool ReSIDfp::batch(const SidWrite* writes, unsigned int n, unsigned int &done)
+{
+    // Grouped chips are clocked together
+    if (m_group != nullptr)
+        return false;
+
+    for (; done < n; done++)
+    {
+        const SidWrite &w = writes[done];
+
+        // Up to one sample per cycle, clock only as much as fits
+        while (m_batchCycles < w.cycles)
+        {
+            const uint_least32_t room = OUTPUTBUFFERSIZE - m_bufferpos;
+            if (room == 0)
+                return true;
+
+            const uint_least32_t cycles = std::min(w.cycles - m_batchCycles, room);
+            m_batchCycles += cycles;
+            m_accessClk += cycles;
+            m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+        }
+
+        m_batchCycles = 0;
+        m_sid.write(w.addr & 0x1f, w.data);
+    }
+
+    return true;
+}
+
 void ReSIDfp::clock()
 {
+    if (m_group != nullptr)
+    {
+        m_group->clock(eventScheduler->getTime(EVENT_CLOCK_PHI1));
+        return;
+    }
+
     const event_clock_t cycles = eventScheduler->getTime(EVENT_CLOCK_PHI1) - m_accessClk;
     m_accessClk += cycles;
     m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
 }
 
+size_t ReSIDfp::memoryUsage() const
+{
+    size_t size = sizeof(ReSIDfp) + m_sid.getMemoryUsage();
+
+    // The group is accounted to its first chip
+    if ((m_group != nullptr) && (m_group->chips().front() == this))
+        size += m_group->memoryUsage();
+
+    return size;
+}
+
+size_t ReSIDfp::sharedMemoryUsage() const
+{
+    return reSIDfp::SID::getSharedMemoryUsage();
+}
+
 void ReSIDfp::filter(bool enable)
 {
       m_sid.enableFilter(enable);
@@ -115,6 +313,12 @@ void ReSIDfp::sampling(float systemclock, float freq,
     case SidConfig::RESAMPLE_INTERPOLATE:
         sampleMethod = reSIDfp::RESAMPLE;
         break;
+    case SidConfig::CLOCK_RATE:
+        sampleMethod = reSIDfp::CLOCK_RATE;
+        break;
+    case SidConfig::RESAMPLE_FAST:
+        sampleMethod = reSIDfp::RESAMPLE_FAST;
+        break;
     default:
         m_status = false;
         m_error = ERR_INVALID_SAMPLING;
@@ -125,6 +329,14 @@ void ReSIDfp::sampling(float systemclock, float freq,
     {
         const int halfFreq = (freq > 44000) ? 20000 : 9 * freq / 20;
         m_sid.setSamplingParameters(systemclock, sampleMethod, freq, halfFreq);
+
+        if (m_group != nullptr)
+            m_group->setSamplingParameters(systemclock, sampleMethod, freq, halfFreq);
+
+        m_systemClock = systemclock;
+        m_samplingFreq = freq;
+        m_highestAccurateFreq = halfFreq;
+        m_samplingMethod = sampleMethod;
     }
     catch (reSIDfp::SIDError const &)
     {
@@ -160,4 +372,89 @@ void ReSIDfp::model(SidConfig::sid_model_t model, bool digiboost)
     m_status = true;
 }
 
+bool ReSIDfp::shareOutput(const std::vector<sidemu*>& chips,
+        const std::vector<int_least32_t>& matrix, unsigned int channels)
+{
+    if ((channels > 2) || (chips.size() < channels) || (chips.front() != this))
+        return false;
+
+    // Sampling parameters not set yet
+    if (m_samplingFreq == 0.)
+        return false;
+
+    std::vector<ReSIDfp*> group;
+    for (std::vector<sidemu*>::const_iterator it = chips.begin(); it != chips.end(); ++it)
+    {
+        // All the chips must come from the same builder
+        if ((*it)->builder() != builder())
+            return false;
+
+        group.push_back(static_cast<ReSIDfp*>(*it));
+    }
+
+    for (std::vector<ReSIDfp*>::const_iterator it = group.begin(); it != group.end(); ++it)
+    {
+        (*it)->ungroup();
+        // Align the chips and discard their pending output
+        (*it)->clock();
+        (*it)->m_bufferpos = 0;
+    }
+
+    ReSIDfpGroup *shared = new (builder()->allocator()) ReSIDfpGroup(group, matrix, channels, builder()->allocator());
+    try
+    {
+        shared->setSamplingParameters(m_systemClock, m_samplingMethod, m_samplingFreq, m_highestAccurateFreq);
+        shared->reset();
+    }
+    catch (reSIDfp::SIDError const &)
+    {
+        delete shared;
+        return false;
+    }
+
+    for (std::vector<ReSIDfp*>::const_iterator it = group.begin(); it != group.end(); ++it)
+    {
+        (*it)->m_group = shared;
+    }
+
+    return true;
+}
+
+void ReSIDfp::unshareOutput()
+{
+    if (m_group == nullptr)
+        return;
+
+    // The chips are clocked together, so they are already aligned
+    const std::vector<ReSIDfp*> chips(m_group->chips().begin(), m_group->chips().end());
+    ungroup();
+
+    // Discard the mixed output
+    for (std::vector<ReSIDfp*>::const_iterator it = chips.begin(); it != chips.end(); ++it)
+    {
+        (*it)->m_bufferpos = 0;
+    }
+}
+
+void ReSIDfp::ungroup()
+{
+    if (m_group == nullptr)
+        return;
+
+    ReSIDfpGroup *group = m_group;
+    const ReSIDfpGroup::chips_t& chips = group->chips();
+    for (ReSIDfpGroup::chips_t::const_iterator it = chips.begin(); it != chips.end(); ++it)
+    {
+        (*it)->m_group = nullptr;
+    }
+
+    delete group;
+}
+
+void ReSIDfp::unlock()
+{
+    ungroup();
+    sidemu::unlock();
+}
+
 }
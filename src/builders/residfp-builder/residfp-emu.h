@@ -24,6 +24,8 @@
 #define RESIDFP_EMU_H
 
 #include <stdint.h>
+#include <new>
+#include <vector>
 
 #include "residfp/SID.h"
 #include "sidplayfp/SidConfig.h"
@@ -38,11 +40,71 @@ class sidbuilder;
 namespace libsidplayfp
 {
 
+class ReSIDfpGroup;
+
+/**
+ * Hands the builder's allocator to reSIDfp,
+ * which doesn't know about SidAllocator.
+ */
+class ReSIDfpAllocator final : public reSIDfp::Allocator
+{
+private:
+    const SidAllocator * const m_allocator;
+
+public:
+    explicit ReSIDfpAllocator(const SidAllocator *allocator) :
+        m_allocator(allocator) {}
+
+    void* allocate(size_t size) override
+    {
+        if (m_allocator == nullptr)
+            return ::operator new(size);
+
+        void *ptr = m_allocator->allocate(size, m_allocator->context);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    void release(void *ptr) override
+    {
+        if (m_allocator == nullptr)
+            ::operator delete(ptr);
+        else
+            m_allocator->release(ptr, m_allocator->context);
+    }
+};
+
 class ReSIDfp final : public sidemu
 {
+    friend class ReSIDfpGroup;
+
 private:
+    /// Where the chip is placed, must outlive it
+    ReSIDfpAllocator m_allocator;
+
     reSIDfp::SID &m_sid;
 
+    /// Chips sharing the output stage, if any
+    ReSIDfpGroup *m_group;
+
+    /// Sampling parameters, needed to setup a shared output stage
+    //@{
+    double m_systemClock;
+    double m_samplingFreq;
+    double m_highestAccurateFreq;
+    reSIDfp::SamplingMethod m_samplingMethod;
+    //@}
+
+    /// Output buffer, kept with the emulation state
+    short m_output[OUTPUTBUFFERSIZE];
+
+private:
+    void ungroup();
+
+protected:
+    bool batch(const SidWrite* writes, unsigned int n, unsigned int &done) override;
+
 public:
     static const char* getCredits();
 
@@ -58,6 +120,8 @@ public:
     // c64sid functions
     void reset(uint8_t volume) override;
 
+    void powerOn() override { m_sid.powerOn(); }
+
     // Standard SID emu functions
     void clock() override;
 
@@ -68,6 +132,16 @@ public:
 
     void model(SidConfig::sid_model_t model, bool digiboost) override;
 
+    bool shareOutput(const std::vector<sidemu*>& chips,
+        const std::vector<int_least32_t>& matrix, unsigned int channels) override;
+
+    void unshareOutput() override;
+
+    void unlock() override;
+
+    size_t memoryUsage() const override;
+    size_t sharedMemoryUsage() const override;
+
     // Specific to resid
     void filter(bool enable);
     void filter6581Curve(double filterCurve);
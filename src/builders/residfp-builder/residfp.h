@@ -31,9 +31,25 @@
  */
 class SID_EXTERN ReSIDfpBuilder: public sidbuilder
 {
+private:
+    /// @name settings last applied, for #settingsHash
+    //@{
+    bool m_filter;
+    double m_filter6581Curve;
+    double m_filter8580Curve;
+    //@}
+
 public:
-    ReSIDfpBuilder(const char * const name) :
-        sidbuilder(name) {}
+    /**
+     * @param name the builder name
+     * @param allocator where to place the emulations, see SidAllocator.
+     *                  0 for the heap. @since 2.7
+     */
+    ReSIDfpBuilder(const char * const name, const SidAllocator *allocator = 0) :
+        sidbuilder(name, allocator),
+        m_filter(true),
+        m_filter6581Curve(0.5),
+        m_filter8580Curve(0.5) {}
     ~ReSIDfpBuilder();
 
     /**
@@ -74,6 +90,8 @@ public:
      */
     void filter8580Curve(double filterCurve);
     //@}
+
+    uint_least64_t settingsHash() const;
 };
 
 #endif // RESIDFP_H
@@ -0,0 +1,119 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ALLOCATED_H
+#define ALLOCATED_H
+
+#include <cstddef>
+#include <new>
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Memory source for the SID and its filters and resamplers.
+ *
+ * The host application adapts its own allocator to this interface.
+ */
+class Allocator
+{
+public:
+    virtual ~Allocator() {}
+
+    /**
+     * Allocate memory.
+     *
+     * @param size the number of bytes
+     * @return memory aligned as for malloc
+     * @throw std::bad_alloc
+     */
+    virtual void* allocate(size_t size) = 0;
+
+    /**
+     * Release memory obtained from #allocate.
+     */
+    virtual void release(void *ptr) = 0;
+};
+
+/**
+ * Base for the objects which can be placed with an Allocator,
+ * using `new (allocator) T(...)`.
+ *
+ * The allocator is stored in front of every block, so the objects
+ * are deleted as usual, also through smart pointers,
+ * and a null allocator falls back to the heap.
+ */
+class Allocated
+{
+private:
+    union header_t
+    {
+        Allocator *allocator;
+
+        // force the maximum alignment
+        long double ld;
+        void *p;
+    };
+
+public:
+    /**
+     * Allocate a block.
+     *
+     * @param size the number of bytes
+     * @param allocator the allocator, nullptr for the heap
+     * @throw std::bad_alloc
+     */
+    static void* allocate(size_t size, Allocator *allocator)
+    {
+        header_t *block = static_cast<header_t*>(allocator != nullptr
+            ? allocator->allocate(sizeof(header_t) + size)
+            : ::operator new(sizeof(header_t) + size));
+
+        block->allocator = allocator;
+        return block + 1;
+    }
+
+    /**
+     * Release a block obtained from #allocate.
+     */
+    static void release(void *ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        header_t *block = static_cast<header_t*>(ptr) - 1;
+        if (block->allocator != nullptr)
+            block->allocator->release(block);
+        else
+            ::operator delete(block);
+    }
+
+    static void* operator new(size_t size, Allocator *allocator) { return allocate(size, allocator); }
+    static void* operator new(size_t size) { return allocate(size, nullptr); }
+
+    static void operator delete(void *ptr, Allocator*) { release(ptr); }
+    static void operator delete(void *ptr) { release(ptr); }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -22,6 +22,8 @@
 
 #include "Dac.h"
 
+#include <cmath>
+
 namespace reSIDfp
 {
 
@@ -120,4 +122,30 @@ void Dac::kinkedDac(ChipModel chipModel)
     }
 }
 
+void buildVoiceDacs(ChipModel chipModel, int* wavDAC, int64_t* envDAC)
+{
+    {
+        Dac dacBuilder(ENV_DAC_BITS);
+        dacBuilder.kinkedDac(chipModel);
+
+        for (unsigned int i = 0; i < (1 << ENV_DAC_BITS); i++)
+        {
+            envDAC[i] = static_cast<int64_t>(dacBuilder.getOutput(i) * (1 << 24) + 0.5);
+        }
+    }
+
+    {
+        Dac dacBuilder(OSC_DAC_BITS);
+        dacBuilder.kinkedDac(chipModel);
+
+        const double offset = dacBuilder.getOutput(chipModel == MOS6581 ? OFFSET_6581 : OFFSET_8580);
+
+        for (unsigned int i = 0; i < (1 << OSC_DAC_BITS); i++)
+        {
+            const double dacValue = dacBuilder.getOutput(i);
+            wavDAC[i] = static_cast<int>(std::floor((dacValue - offset) * (1 << 16) + 0.5));
+        }
+    }
+}
+
 } // namespace reSIDfp
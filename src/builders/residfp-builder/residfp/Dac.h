@@ -23,11 +23,85 @@
 #ifndef DAC_H
 #define DAC_H
 
+#include <stdint.h>
+
 #include "siddefs-fp.h"
 
 namespace reSIDfp
 {
 
+const unsigned int ENV_DAC_BITS = 8;
+const unsigned int OSC_DAC_BITS = 12;
+
+/**
+ * The waveform D/A converter introduces a DC offset in the signal
+ * to the envelope multiplying D/A converter. The "zero" level of
+ * the waveform D/A converter can be found as follows:
+ *
+ * Measure the "zero" voltage of voice 3 on the SID audio output
+ * pin, routing only voice 3 to the mixer ($d417 = $0b, $d418 =
+ * $0f, all other registers zeroed).
+ *
+ * Then set the sustain level for voice 3 to maximum and search for
+ * the waveform output value yielding the same voltage as found
+ * above. This is done by trying out different waveform output
+ * values until the correct value is found, e.g. with the following
+ * program:
+ *
+ *        lda #$08
+ *        sta $d412
+ *        lda #$0b
+ *        sta $d417
+ *        lda #$0f
+ *        sta $d418
+ *        lda #$f0
+ *        sta $d414
+ *        lda #$21
+ *        sta $d412
+ *        lda #$01
+ *        sta $d40e
+ *
+ *        ldx #$00
+ *        lda #$38        ; Tweak this to find the "zero" level
+ *l       cmp $d41b
+ *        bne l
+ *        stx $d40e        ; Stop frequency counter - freeze waveform output
+ *        brk
+ *
+ * The waveform output range is 0x000 to 0xfff, so the "zero"
+ * level should ideally have been 0x800. In the measured chip, the
+ * waveform output "zero" level was found to be 0x380 (i.e. $d41b
+ * = 0x38) at an audio output voltage of 5.94V.
+ *
+ * With knowledge of the mixer op-amp characteristics, further estimates
+ * of waveform voltages can be obtained by sampling the EXT IN pin.
+ * From EXT IN samples, the corresponding waveform output can be found by
+ * using the model for the mixer.
+ *
+ * Such measurements have been done on a chip marked MOS 6581R4AR
+ * 0687 14, and the following results have been obtained:
+ * * The full range of one voice is approximately 1.5V.
+ * * The "zero" level rides at approximately 5.0V.
+ *
+ *
+ * zero-x did the measuring on the 8580 (https://sourceforge.net/p/vice-emu/bugs/1036/#c5b3):
+ * When it sits on basic from powerup it's at 4.72
+ * Run 1.prg and check the output pin level.
+ * Then run 2.prg and adjust it until the output level is the same...
+ * 0x94-0xA8 gives me the same 4.72 1.prg shows.
+ * On another 8580 it's 0x90-0x9C
+ * Third chip 0x94-0xA8
+ * Fourth chip 0x90-0xA4
+ * On the 8580 that plays digis the output is 4.66 and 0x93 is the only value to reach that.
+ * To me that seems as regular 8580s have somewhat wide 0-level range,
+ * whereas that digi-compatible 8580 has it very narrow.
+ * On my 6581R4AR has 0x3A as the only value giving the same output level as 1.prg
+ */
+//@{
+const unsigned int OFFSET_6581 = 0x380;
+const unsigned int OFFSET_8580 = 0x9c0;
+//@}
+
 /**
  * Estimate DAC nonlinearity.
  * The SID DACs are built up as R-2R ladder as follows:
@@ -106,6 +180,19 @@ public:
     double getOutput(unsigned int input) const;
 };
 
+/**
+ * Build the lookup tables of the voice DACs, see Voice.
+ * The waveform output is taken from the "zero" level
+ * of the chip model and scaled by 2^16,
+ * the envelope output is scaled by 2^24:
+ * its full scale needs more than 32 bits.
+ *
+ * @param chipModel 6581 or 8580
+ * @param wavDAC filled with the 2^OSC_DAC_BITS waveform outputs
+ * @param envDAC filled with the 2^ENV_DAC_BITS envelope outputs
+ */
+void buildVoiceDacs(ChipModel chipModel, int* wavDAC, int64_t* envDAC);
+
 } // namespace reSIDfp
 
 #endif
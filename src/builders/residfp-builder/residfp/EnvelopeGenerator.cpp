@@ -59,6 +59,17 @@ const unsigned int EnvelopeGenerator::adsrtable[16] =
     0x64a8
 };
 
+void EnvelopeGenerator::powerOn()
+{
+    lfsr = 0x7fff;
+    exponential_pipeline = 0;
+    next_state = RELEASE;
+    envelope_counter = 0xaa;
+    env3 = 0;
+
+    reset();
+}
+
 void EnvelopeGenerator::reset()
 {
     // counter is not changed on reset
@@ -159,6 +159,12 @@ public:
      */
     void reset();
 
+    /**
+     * Bring the generator to the power-on state,
+     * including the counters which survive a reset.
+     */
+    void powerOn();
+
     /**
      * Write control register.
      *
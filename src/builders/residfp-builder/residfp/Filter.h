@@ -23,13 +23,15 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+#include "Allocated.h"
+
 namespace reSIDfp
 {
 
 /**
  * SID filter base class
  */
-class Filter
+class Filter : public Allocated
 {
 protected:
     /// Current volume amplifier setting.
@@ -141,6 +143,17 @@ public:
      */
     void reset();
 
+    /**
+     * Clear the filter state to the power-on one.
+     * Unlike reset this also discharges the capacitors.
+     */
+    virtual void powerOn()
+    {
+        Vhp = 0;
+        Vbp = 0;
+        Vlp = 0;
+    }
+
     /**
      * Write Frequency Cutoff Low register.
      *
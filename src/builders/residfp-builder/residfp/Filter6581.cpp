@@ -29,16 +29,11 @@
 namespace reSIDfp
 {
 
-Filter6581::~Filter6581()
-{
-    delete [] f0_dac;
-}
-
 void Filter6581::updatedCenterFrequency()
 {
     const unsigned short Vw = f0_dac[fc];
-    hpIntegrator->setVw(Vw);
-    bpIntegrator->setVw(Vw);
+    hpIntegrator.setVw(Vw);
+    bpIntegrator.setVw(Vw);
 }
 
 void Filter6581::updatedMixing()
@@ -67,8 +62,7 @@ void Filter6581::updatedMixing()
 
 void Filter6581::setFilterCurve(double curvePosition)
 {
-    delete [] f0_dac;
-    f0_dac = FilterModelConfig6581::getInstance()->getDAC(curvePosition);
+    FilterModelConfig6581::getInstance()->getDAC(curvePosition, f0_dac);
     updatedCenterFrequency();
 }
 
@@ -29,14 +29,13 @@
 
 #include "Filter.h"
 #include "FilterModelConfig6581.h"
+#include "Integrator6581.h"
 
 #include "sidcxx11.h"
 
 namespace reSIDfp
 {
 
-class Integrator6581;
-
 /**
  * The SID filter is modeled with a two-integrator-loop biquadratic filter,
  * which has been confirmed by Bob Yannes to be the actual circuit used in
@@ -322,7 +321,8 @@ class Integrator6581;
 class Filter6581 final : public Filter
 {
 private:
-    const unsigned short* f0_dac;
+    /// Cutoff frequency DAC output, depends on the filter curve
+    unsigned short f0_dac[1 << FilterModelConfig6581::DAC_BITS];
 
     unsigned short** mixer;
     unsigned short** summer;
@@ -333,10 +333,10 @@ private:
     const int voiceDC;
 
     /// VCR + associated capacitor connected to highpass output.
-    std::unique_ptr<Integrator6581> const hpIntegrator;
+    Integrator6581 hpIntegrator;
 
     /// VCR + associated capacitor connected to bandpass output.
-    std::unique_ptr<Integrator6581> const bpIntegrator;
+    Integrator6581 bpIntegrator;
 
 protected:
     /**
@@ -355,7 +355,6 @@ protected:
 
 public:
     Filter6581() :
-        f0_dac(FilterModelConfig6581::getInstance()->getDAC(0.5)),
         mixer(FilterModelConfig6581::getInstance()->getMixer()),
         summer(FilterModelConfig6581::getInstance()->getSummer()),
         gain_res(FilterModelConfig6581::getInstance()->getGainRes()),
@@ -365,13 +364,19 @@ public:
         hpIntegrator(FilterModelConfig6581::getInstance()->buildIntegrator()),
         bpIntegrator(FilterModelConfig6581::getInstance()->buildIntegrator())
     {
+        FilterModelConfig6581::getInstance()->getDAC(0.5, f0_dac);
         input(0);
     }
 
-    ~Filter6581();
-
     unsigned short clock(int voice1, int voice2, int voice3) override;
 
+    void powerOn() override
+    {
+        Filter::powerOn();
+        hpIntegrator.reset();
+        bpIntegrator.reset();
+    }
+
     void input(int sample) override { ve = (sample * voiceScaleS11 * 3 >> 11) + mixer[0][0]; }
 
     /**
@@ -380,6 +385,11 @@ public:
      * @param curvePosition 0 .. 1, where 0 sets center frequency high ("light") and 1 sets it low ("dark"), default is 0.5
      */
     void setFilterCurve(double curvePosition);
+
+    /**
+     * Get the memory owned by this filter, in bytes.
+     */
+    size_t getMemoryUsage() const { return sizeof(Filter6581); }
 };
 
 } // namespace reSIDfp
@@ -408,8 +418,8 @@ unsigned short Filter6581::clock(int voice1, int voice2, int voice3)
     (filtE ? Vi : Vo) += ve;
 
     Vhp = currentSummer[currentResonance[Vbp] + Vlp + Vi];
-    Vbp = hpIntegrator->solve(Vhp);
-    Vlp = bpIntegrator->solve(Vbp);
+    Vbp = hpIntegrator.solve(Vhp);
+    Vlp = bpIntegrator.solve(Vbp);
 
     if (lp) Vo += Vlp;
     if (bp) Vo += Vbp;
@@ -29,39 +29,13 @@
 namespace reSIDfp
 {
 
-/**
- * W/L ratio of frequency DAC bit 0,
- * other bit are proportional.
- * When no bit are selected a resistance with half
- * W/L ratio is selected.
- */
-const double DAC_WL0 = 0.00615;
-
 Filter8580::~Filter8580() {}
 
 void Filter8580::updatedCenterFrequency()
 {
-    double wl;
-    double dacWL = DAC_WL0;
-    if (fc)
-    {
-        wl = 0.;
-        for (unsigned int i = 0; i < 11; i++)
-        {
-            if (fc & (1 << i))
-            {
-                wl += dacWL;
-            }
-            dacWL *= 2.;
-        }
-    }
-    else
-    {
-        wl = dacWL/2.;
-    }
-
-    hpIntegrator->setFc(wl);
-    bpIntegrator->setFc(wl);
+    const unsigned short n_dac = fc_dac[fc];
+    hpIntegrator.setFc(n_dac);
+    bpIntegrator.setFc(n_dac);
 }
 
 void Filter8580::updatedMixing()
@@ -94,8 +68,8 @@ void Filter8580::setFilterCurve(double curvePosition)
     // 1.2 <= cp <= 1.8
     cp = 1.8 - curvePosition * 3./5.;
 
-    hpIntegrator->setV(cp);
-    bpIntegrator->setV(cp);
+    hpIntegrator.setV(cp);
+    bpIntegrator.setV(cp);
 }
 
 } // namespace reSIDfp
@@ -36,8 +36,6 @@
 namespace reSIDfp
 {
 
-class Integrator8580;
-
 /**
  * Filter for 8580 chip
  * --------------------
@@ -286,16 +284,19 @@ private:
     unsigned short** gain_res;
     unsigned short** gain_vol;
 
+    /// Cutoff current factors, indexed by FC
+    const unsigned short* fc_dac;
+
     const int voiceScaleS11;
     const int voiceDC;
 
     double cp;
 
     /// VCR + associated capacitor connected to highpass output.
-    std::unique_ptr<Integrator8580> const hpIntegrator;
+    Integrator8580 hpIntegrator;
 
     /// VCR + associated capacitor connected to bandpass output.
-    std::unique_ptr<Integrator8580> const bpIntegrator;
+    Integrator8580 bpIntegrator;
 
 protected:
     /**
@@ -318,6 +319,7 @@ public:
         summer(FilterModelConfig8580::getInstance()->getSummer()),
         gain_res(FilterModelConfig8580::getInstance()->getGainRes()),
         gain_vol(FilterModelConfig8580::getInstance()->getGainVol()),
+        fc_dac(FilterModelConfig8580::getInstance()->getFcDac()),
         voiceScaleS11(FilterModelConfig8580::getInstance()->getVoiceScaleS11()),
         voiceDC(FilterModelConfig8580::getInstance()->getNormalizedVoiceDC()),
         cp(0.5),
@@ -332,6 +334,13 @@ public:
 
     unsigned short clock(int voice1, int voice2, int voice3) override;
 
+    void powerOn() override
+    {
+        Filter::powerOn();
+        hpIntegrator.reset();
+        bpIntegrator.reset();
+    }
+
     void input(int sample) override { ve = (sample * voiceScaleS11 * 3 >> 11) + mixer[0][0]; }
 
     /**
@@ -340,6 +349,11 @@ public:
      * @param curvePosition 0 .. 1, where 0 sets center frequency high ("light") and 1 sets it low ("dark"), default is 0.5
      */
     void setFilterCurve(double curvePosition);
+
+    /**
+     * Get the memory owned by this filter, in bytes.
+     */
+    size_t getMemoryUsage() const { return sizeof(Filter8580); }
 };
 
 } // namespace reSIDfp
@@ -366,8 +380,8 @@ unsigned short Filter8580::clock(int voice1, int voice2, int voice3)
     (filtE ? Vi : Vo) += ve;
 
     Vhp = currentSummer[currentResonance[Vbp] + Vlp + Vi];
-    Vbp = hpIntegrator->solve(Vhp);
-    Vlp = bpIntegrator->solve(Vbp);
+    Vbp = hpIntegrator.solve(Vhp);
+    Vlp = bpIntegrator.solve(Vbp);
 
     if (lp) Vo += Vlp;
     if (bp) Vo += Vbp;
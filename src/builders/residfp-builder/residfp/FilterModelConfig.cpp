@@ -79,4 +79,20 @@ FilterModelConfig::FilterModelConfig(
     }
 }
 
+size_t FilterModelConfig::getTablesSize() const
+{
+    // See the derived class constructors for the table sizes
+    size_t entries = 1;             // mixer with no inputs
+
+    for (int i = 0; i < 5; i++)
+        entries += (2 + i) << 16;   // summer, 2 - 6 inputs
+
+    for (int i = 1; i < 8; i++)
+        entries += i << 16;         // mixer, 1 - 7 inputs
+
+    entries += 2 * (16 << 16);      // gain_vol and gain_res
+
+    return entries * sizeof(unsigned short);
+}
+
 } // namespace reSIDfp
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 
 #include "Spline.h"
 
@@ -134,6 +135,11 @@ public:
      */
     int getNormalizedVoiceDC() const { return static_cast<int>(N16 * (voice_DC_voltage - vmin)); }
 
+    /**
+     * Get the size of the gain and summer tables, in bytes.
+     */
+    size_t getTablesSize() const;
+
     inline unsigned short getOpampRev(int i) const { return opamp_rev[i]; }
     inline double getVddt() const { return Vddt; }
     inline double getVth() const { return Vth; }
@@ -113,6 +113,15 @@ FilterModelConfig6581* FilterModelConfig6581::getInstance()
     return instance.get();
 }
 
+size_t FilterModelConfig6581::getMemoryUsage()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(Instance6581_Lock);
+#endif
+
+    return instance.get() ? sizeof(FilterModelConfig6581) + instance->getTablesSize() : 0;
+}
+
 FilterModelConfig6581::FilterModelConfig6581() :
     FilterModelConfig(
         1.5,     // voice voltage range
@@ -319,24 +328,20 @@ FilterModelConfig6581::FilterModelConfig6581() :
     }
 }
 
-unsigned short* FilterModelConfig6581::getDAC(double adjustment) const
+void FilterModelConfig6581::getDAC(double adjustment, unsigned short* f0_dac) const
 {
     const double dac_zero = getDacZero(adjustment);
 
-    unsigned short* f0_dac = new unsigned short[1 << DAC_BITS];
-
     for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
     {
         const double fcd = dac.getOutput(i);
         f0_dac[i] = getNormalizedValue(dac_zero + fcd * dac_scale / (1 << DAC_BITS));
     }
-
-    return f0_dac;
 }
 
-std::unique_ptr<Integrator6581> FilterModelConfig6581::buildIntegrator()
+Integrator6581 FilterModelConfig6581::buildIntegrator()
 {
-    return MAKE_UNIQUE(Integrator6581, this, WL_snake);
+    return Integrator6581(this, WL_snake);
 }
 
 } // namespace reSIDfp
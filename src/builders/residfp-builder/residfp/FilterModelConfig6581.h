@@ -41,7 +41,7 @@ class Integrator6581;
  */
 class FilterModelConfig6581 final : public FilterModelConfig
 {
-private:
+public:
     static const unsigned int DAC_BITS = 11;
 
 private:
@@ -83,22 +83,26 @@ private:
 public:
     static FilterModelConfig6581* getInstance();
 
+    /**
+     * Get the memory used by the model tables, in bytes,
+     * zero if they have not been built.
+     */
+    static size_t getMemoryUsage();
+
     /**
      * Construct an 11 bit cutoff frequency DAC output voltage table.
-     * Ownership is transferred to the requester which becomes responsible
-     * of freeing the object when done.
      *
      * @param adjustment
-     * @return the DAC table
+     * @param f0_dac the table to fill, 1 << DAC_BITS entries
      */
-    unsigned short* getDAC(double adjustment) const;
+    void getDAC(double adjustment, unsigned short* f0_dac) const;
 
     /**
      * Construct an integrator solver.
      *
      * @return the integrator
      */
-    std::unique_ptr<Integrator6581> buildIntegrator();
+    Integrator6581 buildIntegrator();
 
     inline unsigned short getVcr_nVg(int i) const { return vcr_nVg[i]; }
     inline unsigned short getVcr_n_Ids_term(int i) const { return vcr_n_Ids_term[i]; }
@@ -82,6 +82,14 @@ const double resGain[16] =
       ((1.4*4.7)/(1.4+4.7))/2.8, // (Rf|R3)/RC   0.385246
 };
 
+/**
+ * W/L ratio of frequency DAC bit 0,
+ * other bit are proportional.
+ * When no bit are selected a resistance with half
+ * W/L ratio is selected.
+ */
+const double DAC_WL0 = 0.00615;
+
 const unsigned int OPAMP_SIZE = 21;
 
 /**
@@ -133,6 +141,15 @@ FilterModelConfig8580* FilterModelConfig8580::getInstance()
     return instance.get();
 }
 
+size_t FilterModelConfig8580::getMemoryUsage()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(Instance8580_Lock);
+#endif
+
+    return instance.get() ? sizeof(FilterModelConfig8580) + instance->getTablesSize() : 0;
+}
+
 FilterModelConfig8580::FilterModelConfig8580() :
     FilterModelConfig(
         0.30,   // voice voltage range FIXME measure
@@ -145,6 +162,32 @@ FilterModelConfig8580::FilterModelConfig8580() :
         OPAMP_SIZE
     )
 {
+    // Normalized current factors for the cutoff resistor,
+    // 1 cycle at 1MHz.
+    for (unsigned int fc = 0; fc < (1 << 11); fc++)
+    {
+        double wl;
+        double dacWL = DAC_WL0;
+        if (fc)
+        {
+            wl = 0.;
+            for (unsigned int i = 0; i < 11; i++)
+            {
+                if (fc & (1 << i))
+                {
+                    wl += dacWL;
+                }
+                dacWL *= 2.;
+            }
+        }
+        else
+        {
+            wl = dacWL/2.;
+        }
+
+        fcDac[fc] = getNormalizedCurrentFactor(wl);
+    }
+
     // Create lookup tables for gains / summers.
 #ifndef _OPENMP
     OpAmp opampModel(
@@ -287,9 +330,9 @@ FilterModelConfig8580::FilterModelConfig8580() :
     }
 }
 
-std::unique_ptr<Integrator8580> FilterModelConfig8580::buildIntegrator()
+Integrator8580 FilterModelConfig8580::buildIntegrator()
 {
-    return MAKE_UNIQUE(Integrator8580, this);
+    return Integrator8580(this);
 }
 
 } // namespace reSIDfp
@@ -48,6 +48,10 @@ private:
     friend class std::auto_ptr<FilterModelConfig8580>;
 #endif
 
+private:
+    /// Cutoff resistor current factors for all the FC values
+    unsigned short fcDac[1 << 11];
+
 private:
     FilterModelConfig8580();
     ~FilterModelConfig8580() DEFAULT;
@@ -55,12 +59,24 @@ private:
 public:
     static FilterModelConfig8580* getInstance();
 
+    /**
+     * Get the memory used by the model tables, in bytes,
+     * zero if they have not been built.
+     */
+    static size_t getMemoryUsage();
+
+    /**
+     * Get the normalized current factors of the
+     * cutoff resistor, indexed by the FC register value.
+     */
+    const unsigned short* getFcDac() const { return fcDac; }
+
     /**
      * Construct an integrator solver.
      *
      * @return the integrator
      */
-    std::unique_ptr<Integrator8580> buildIntegrator();
+    Integrator8580 buildIntegrator();
 };
 
 } // namespace reSIDfp
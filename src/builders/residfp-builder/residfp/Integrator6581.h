@@ -199,6 +199,11 @@ public:
         nSnake(fmc->getNormalizedCurrentFactor(WL_snake)),
         fmc(fmc) {}
 
+    /**
+     * Discharge the capacitor.
+     */
+    void reset() { vx = 0; vc = 0; }
+
     void setVw(unsigned short Vw) { nVddt_Vw_2 = ((nVddt - Vw) * (nVddt - Vw)) >> 1; }
 
     int solve(int vi) const;
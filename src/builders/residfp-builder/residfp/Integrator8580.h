@@ -72,14 +72,11 @@ public:
     }
 
     /**
-     * Set Filter Cutoff resistor ratio.
+     * Set Filter Cutoff resistor current factor.
+     *
+     * @param n normalized current factor, see FilterModelConfig8580::getFcDac
      */
-    void setFc(double wl)
-    {
-        // Normalized current factor, 1 cycle at 1MHz.
-        // Fit in 5 bits.
-        n_dac = fmc->getNormalizedCurrentFactor(wl);
-    }
+    void setFc(unsigned short n) { n_dac = n; }
 
     /**
      * Set FC gate voltage multiplier.
@@ -97,6 +94,11 @@ public:
         nVgt = fmc->getNormalizedValue(Vgt);
     }
 
+    /**
+     * Discharge the capacitor.
+     */
+    void reset() { vx = 0; vc = 0; }
+
     int solve(int vi) const;
 };
 
@@ -0,0 +1,74 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2011-2016 Leandro Nini <drfiemost@users.sourceforge.net>
+ * Copyright 2007-2010 Antti Lankila
+ * Copyright 2004 Dag Lem <resid@nimrod.no>
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "OutputStage.h"
+
+#include "SID.h"
+#include "resample/BoxcarResampler.h"
+#include "resample/CicResampler.h"
+#include "resample/TwoPassSincResampler.h"
+#include "resample/ZeroOrderResampler.h"
+
+namespace reSIDfp
+{
+
+Resampler* OutputStage::createResampler(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency,
+    Allocator *allocator)
+{
+    switch (method)
+    {
+    case DECIMATE:
+        return new (allocator) ZeroOrderResampler(clockFrequency, samplingFrequency);
+
+    case RESAMPLE:
+        return TwoPassSincResampler::create(clockFrequency, samplingFrequency, highestAccurateFrequency, allocator);
+
+    case CLOCK_RATE:
+        return new (allocator) BoxcarResampler(clockFrequency, samplingFrequency);
+
+    case RESAMPLE_FAST:
+        return CicResampler::create(clockFrequency, samplingFrequency, highestAccurateFrequency, allocator);
+
+    default:
+        throw SIDError("Unknown sampling method");
+    }
+}
+
+void OutputStage::setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency,
+    Allocator *allocator)
+{
+    externalFilter.setClockFrequency(clockFrequency);
+    resampler.reset(createResampler(clockFrequency, method, samplingFrequency, highestAccurateFrequency, allocator));
+}
+
+void OutputStage::reset()
+{
+    externalFilter.reset();
+
+    if (resampler.get())
+    {
+        resampler->reset();
+    }
+}
+
+} // namespace reSIDfp
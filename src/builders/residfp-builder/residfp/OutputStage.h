@@ -0,0 +1,97 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2011-2016 Leandro Nini <drfiemost@users.sourceforge.net>
+ * Copyright 2007-2010 Antti Lankila
+ * Copyright 2004 Dag Lem <resid@nimrod.no>
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef OUTPUTSTAGE_H
+#define OUTPUTSTAGE_H
+
+#include <memory>
+
+#include "siddefs-fp.h"
+#include "ExternalFilter.h"
+#include "resample/Resampler.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * The board output stage: external filter followed by the resampler.
+ *
+ * Every SID has its own; a standalone stage lets several chips
+ * be summed at clock rate and filtered and resampled only once.
+ */
+class OutputStage
+{
+private:
+    ExternalFilter externalFilter;
+
+    std::unique_ptr<Resampler> resampler;
+
+public:
+    /**
+     * Create a resampler for the given sampling parameters.
+     *
+     * @param allocator where to place the resampler, nullptr for the heap
+     * @throw SIDError
+     */
+    static Resampler* createResampler(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency,
+        Allocator *allocator = nullptr);
+
+    /**
+     * Setup the sampling parameters.
+     *
+     * @param allocator where to place the resampler, nullptr for the heap
+     * @see SID::setSamplingParameters
+     * @throw SIDError
+     */
+    void setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency,
+        Allocator *allocator = nullptr);
+
+    void reset();
+
+    /**
+     * Input a chip output sample at clock rate.
+     *
+     * @param sample the SID output before the external filter
+     * @return true when a sample is ready
+     */
+    bool input(unsigned short sample) { return resampler->input(externalFilter.clock(sample)); }
+
+    /**
+     * Get the resampled output.
+     */
+    short getOutput() const { return resampler->getOutput(); }
+
+    /**
+     * Get the memory owned by the output stage, in bytes.
+     */
+    size_t getMemoryUsage() const
+    {
+        return sizeof(OutputStage) + (resampler.get() ? resampler->getMemoryUsage() : 0);
+    }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -24,9 +24,14 @@
 #define SIDFP_H
 
 #include <memory>
+#include <cstddef>
 
 #include "siddefs-fp.h"
+#include "ExternalFilter.h"
+#include "Potentiometer.h"
+#include "Voice.h"
 
+#include "Allocated.h"
 #include "sidcxx11.h"
 
 namespace reSIDfp
@@ -35,9 +40,6 @@ namespace reSIDfp
 class Filter;
 class Filter6581;
 class Filter8580;
-class ExternalFilter;
-class Potentiometer;
-class Voice;
 class Resampler;
 
 /**
@@ -57,35 +59,38 @@ public:
 /**
  * MOS6581/MOS8580 emulation.
  */
-class SID
+class SID : public Allocated
 {
 private:
-    /// Currently active filter
+    /// Where the filters and the resampler are placed
+    Allocator *allocator;
+
+    /// Currently active filter, selected on first clock
     Filter* filter;
 
-    /// Filter used, if model is set to 6581
-    std::unique_ptr<Filter6581> const filter6581;
+    /// Filter used, if model is set to 6581, built on first use
+    std::unique_ptr<Filter6581> filter6581;
 
-    /// Filter used, if model is set to 8580
-    std::unique_ptr<Filter8580> const filter8580;
+    /// Filter used, if model is set to 8580, built on first use
+    std::unique_ptr<Filter8580> filter8580;
 
     /**
      * External filter that provides high-pass and low-pass filtering
      * to adjust sound tone slightly.
      */
-    std::unique_ptr<ExternalFilter> const externalFilter;
+    ExternalFilter externalFilter;
 
     /// Resampler used by audio generation code.
     std::unique_ptr<Resampler> resampler;
 
     /// Paddle X register support
-    std::unique_ptr<Potentiometer> const potX;
+    Potentiometer potX;
 
     /// Paddle Y register support
-    std::unique_ptr<Potentiometer> const potY;
+    Potentiometer potY;
 
     /// SID voices
-    std::unique_ptr<Voice> voice[3];
+    Voice voice[3];
 
     /// Time to live for the last written value
     int busValueTtl;
@@ -99,27 +104,30 @@ private:
     /// Currently active chip model.
     ChipModel model;
 
+    /// Filter settings, kept for the filters not yet built
+    //@{
+    double filter6581Curve;
+    double filter8580Curve;
+    int inputValue;
+    bool filterEnabled;
+    //@}
+
+    /// Last values written to the filter registers
+    unsigned char filterRegs[4];
+
     /// Last written value
     unsigned char busValue;
 
     /// Flags for muted channels
     bool muted[3];
 
+private:
     /**
-     * Emulated nonlinearity of the envelope DAC.
-     *
-     * @See Dac
-     */
-    float envDAC[256];
-
-    /**
-     * Emulated nonlinearity of the oscillator DAC.
-     *
-     * @See Dac
+     * Select the filter for the current chip model,
+     * building it on first use.
      */
-    float oscDAC[4096];
+    void setFilter();
 
-private:
     /**
      * Age the bus value and zero it if it's TTL has expired.
      *
@@ -127,12 +135,35 @@ private:
      */
     void ageBusValue(unsigned int n);
 
+    /**
+     * Get the chip output, before the external filter.
+     */
+    unsigned short chipOutput();
+
     /**
      * Get output sample.
      *
      * @return the output sample
      */
-    int output() const;
+    int output();
+
+    /**
+     * Store the last sample produced by the resampler.
+     */
+    //@{
+    void getSample(short& sample) const;
+    void getSample(float& sample) const;
+    //@}
+
+    /**
+     * Clock SID forward feeding the resampler.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    template<typename T>
+    int clockResampled(unsigned int cycles, T* buf);
 
     /**
      * Calculate the numebr of cycles according to current parameters
@@ -143,7 +174,11 @@ private:
     void voiceSync(bool sync);
 
 public:
-    SID();
+    /**
+     * @param alloc where to place the filters and the resampler,
+     *              nullptr for the heap
+     */
+    SID(Allocator* alloc = nullptr);
     ~SID();
 
     /**
@@ -164,6 +199,15 @@ public:
      */
     void reset();
 
+    /**
+     * Bring the chip to the power-on state.
+     * Besides resetting, this also clears the oscillators,
+     * the envelope counters and the filter state which a reset
+     * leaves untouched, so that the output only depends
+     * on what is played afterwards.
+     */
+    void powerOn();
+
     /**
      * 16-bit input (EXT IN). Write 16-bit sample to audio input. NB! The caller
      * is responsible for keeping the value within 16 bits. Note that to mix in
@@ -236,6 +280,12 @@ public:
      * @param samplingFrequency Desired output sampling rate
      * @param highestAccurateFrequency
      * @throw SIDError
+     *
+     * With the CLOCK_RATE method the signal is not resampled but only
+     * decimated by the integer factor closest to
+     * clockFrequency / samplingFrequency, so the output rate is
+     * clockFrequency / factor. Use a sampling frequency equal to the
+     * clock frequency to get one sample per cycle.
      */
     void setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency);
 
@@ -248,6 +298,26 @@ public:
      */
     int clock(unsigned int cycles, short* buf);
 
+    /**
+     * Clock SID forward using chosen output sampling algorithm.
+     * Samples are not clipped and full scale is 1.0.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clock(unsigned int cycles, float* buf);
+
+    /**
+     * Clock SID forward producing the chip output at clock rate,
+     * before the external filter.
+     * Used to mix several chips into a shared OutputStage.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf output buffer, one sample per cycle
+     */
+    void clockChipOutput(unsigned int cycles, unsigned short* buf);
+
     /**
      * Clock SID forward with no audio production.
      *
@@ -280,6 +350,17 @@ public:
      * @param enable false to turn off filter emulation
      */
     void enableFilter(bool enable);
+
+    /**
+     * Get the memory owned by this chip, in bytes.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Get the memory used by the lookup tables
+     * shared among all the chips, in bytes.
+     */
+    static size_t getSharedMemoryUsage();
 };
 
 } // namespace reSIDfp
@@ -312,19 +393,41 @@ void SID::ageBusValue(unsigned int n)
 }
 
 RESID_INLINE
-int SID::output() const
+unsigned short SID::chipOutput()
 {
-    const int v1 = voice[0]->output(voice[2]->wave());
-    const int v2 = voice[1]->output(voice[0]->wave());
-    const int v3 = voice[2]->output(voice[1]->wave());
+    const int v1 = voice[0].output(voice[2].wave());
+    const int v2 = voice[1].output(voice[0].wave());
+    const int v3 = voice[2].output(voice[1].wave());
 
-    return externalFilter->clock(filter->clock(v1, v2, v3));
+    return filter->clock(v1, v2, v3);
+}
+
+RESID_INLINE
+int SID::output()
+{
+    return externalFilter.clock(chipOutput());
 }
 
 
 RESID_INLINE
-int SID::clock(unsigned int cycles, short* buf)
+void SID::getSample(short& sample) const
+{
+    sample = resampler->getOutput();
+}
+
+RESID_INLINE
+void SID::getSample(float& sample) const
 {
+    sample = resampler->getFloatOutput();
+}
+
+template<typename T>
+RESID_INLINE
+int SID::clockResampled(unsigned int cycles, T* buf)
+{
+    if (unlikely(filter == nullptr))
+        setFilter();
+
     ageBusValue(cycles);
     int s = 0;
 
@@ -337,18 +440,18 @@ int SID::clock(unsigned int cycles, short* buf)
             for (unsigned int i = 0; i < delta_t; i++)
             {
                 // clock waveform generators
-                voice[0]->wave()->clock();
-                voice[1]->wave()->clock();
-                voice[2]->wave()->clock();
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
 
                 // clock envelope generators
-                voice[0]->envelope()->clock();
-                voice[1]->envelope()->clock();
-                voice[2]->envelope()->clock();
+                voice[0].envelope()->clock();
+                voice[1].envelope()->clock();
+                voice[2].envelope()->clock();
 
                 if (unlikely(resampler->input(output())))
                 {
-                    buf[s++] = resampler->getOutput();
+                    getSample(buf[s++]);
                 }
             }
 
@@ -365,6 +468,58 @@ int SID::clock(unsigned int cycles, short* buf)
     return s;
 }
 
+RESID_INLINE
+int SID::clock(unsigned int cycles, short* buf)
+{
+    return clockResampled(cycles, buf);
+}
+
+RESID_INLINE
+int SID::clock(unsigned int cycles, float* buf)
+{
+    return clockResampled(cycles, buf);
+}
+
+RESID_INLINE
+void SID::clockChipOutput(unsigned int cycles, unsigned short* buf)
+{
+    if (unlikely(filter == nullptr))
+        setFilter();
+
+    ageBusValue(cycles);
+
+    while (cycles != 0)
+    {
+        unsigned int delta_t = std::min(nextVoiceSync, cycles);
+
+        if (likely(delta_t > 0))
+        {
+            for (unsigned int i = 0; i < delta_t; i++)
+            {
+                // clock waveform generators
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
+
+                // clock envelope generators
+                voice[0].envelope()->clock();
+                voice[1].envelope()->clock();
+                voice[2].envelope()->clock();
+
+                *buf++ = chipOutput();
+            }
+
+            cycles -= delta_t;
+            nextVoiceSync -= delta_t;
+        }
+
+        if (unlikely(nextVoiceSync == 0))
+        {
+            voiceSync(true);
+        }
+    }
+}
+
 } // namespace reSIDfp
 
 #endif
@@ -25,6 +25,8 @@
 
 #include <memory>
 
+#include <stdint.h>
+
 #include "siddefs-fp.h"
 #include "WaveformGenerator.h"
 #include "EnvelopeGenerator.h"
@@ -40,17 +42,32 @@ namespace reSIDfp
 class Voice
 {
 private:
-    std::unique_ptr<WaveformGenerator> const waveformGenerator;
+    WaveformGenerator waveformGenerator;
 
-    std::unique_ptr<EnvelopeGenerator> const envelopeGenerator;
+    EnvelopeGenerator envelopeGenerator;
 
-    /// The DAC LUT for analog waveform output
-    float* wavDAC; //-V730_NOINIT this is initialized in the SID constructor
+    /// The DAC LUT for analog waveform output, scaled by 2^16
+    const int* wavDAC; //-V730_NOINIT this is initialized in the SID constructor
 
-    /// The DAC LUT for analog envelope output
-    float* envDAC; //-V730_NOINIT this is initialized in the SID constructor
+    /// The DAC LUT for analog envelope output, scaled by 2^24
+    const int64_t* envDAC; //-V730_NOINIT this is initialized in the SID constructor
 
 public:
+    /**
+     * Multiply the DAC outputs in fixed point, truncating toward zero.
+     * The result differs by at most one from the product
+     * of the unscaled outputs.
+     *
+     * @param wav the waveform DAC output scaled by 2^16
+     * @param env the envelope DAC output scaled by 2^24
+     * @return the product
+     */
+    static int multiply(int wav, int64_t env)
+    {
+        const int64_t out = wav * env;
+        return static_cast<int>((out + ((out >> 63) & 0xffffffffffLL)) >> 40);
+    }
+
     /**
      * Amplitude modulated waveform output.
      *
@@ -67,42 +84,37 @@ public:
      * @return the voice analog output
      */
     RESID_INLINE
-    int output(const WaveformGenerator* ringModulator) const
+    int output(const WaveformGenerator* ringModulator)
     {
-        unsigned int const wav = waveformGenerator->output(ringModulator);
-        unsigned int const env = envelopeGenerator->output();
+        unsigned int const wav = waveformGenerator.output(ringModulator);
+        unsigned int const env = envelopeGenerator.output();
 
         // DAC imperfections are emulated by using the digital output
         // as an index into a DAC lookup table.
-        return static_cast<int>(wavDAC[wav] * envDAC[env]);
+        return multiply(wavDAC[wav], envDAC[env]);
     }
 
-    /**
-     * Constructor.
-     */
-    Voice() :
-        waveformGenerator(new WaveformGenerator()),
-        envelopeGenerator(new EnvelopeGenerator()) {}
-
     /**
      * Set the analog DAC emulation for waveform generator.
      * Must be called before any operation.
      *
-     * @param dac
+     * @param dac the DAC outputs scaled by 2^16
      */
-    void setWavDAC(float* dac) { wavDAC = dac; }
+    void setWavDAC(const int* dac) { wavDAC = dac; }
 
     /**
      * Set the analog DAC emulation for envelope.
      * Must be called before any operation.
      *
-     * @param dac
+     * @param dac the DAC outputs scaled by 2^24
      */
-    void setEnvDAC(float* dac) { envDAC = dac; }
+    void setEnvDAC(const int64_t* dac) { envDAC = dac; }
 
-    WaveformGenerator* wave() const { return waveformGenerator.get(); }
+    WaveformGenerator* wave() { return &waveformGenerator; }
+    const WaveformGenerator* wave() const { return &waveformGenerator; }
 
-    EnvelopeGenerator* envelope() const { return envelopeGenerator.get(); }
+    EnvelopeGenerator* envelope() { return &envelopeGenerator; }
+    const EnvelopeGenerator* envelope() const { return &envelopeGenerator; }
 
     /**
      * Write control register.
@@ -111,8 +123,8 @@ public:
      */
     void writeCONTROL_REG(unsigned char control)
     {
-        waveformGenerator->writeCONTROL_REG(control);
-        envelopeGenerator->writeCONTROL_REG(control);
+        waveformGenerator.writeCONTROL_REG(control);
+        envelopeGenerator.writeCONTROL_REG(control);
     }
 
     /**
@@ -120,8 +132,17 @@ public:
      */
     void reset()
     {
-        waveformGenerator->reset();
-        envelopeGenerator->reset();
+        waveformGenerator.reset();
+        envelopeGenerator.reset();
+    }
+
+    /**
+     * SID power-on.
+     */
+    void powerOn()
+    {
+        waveformGenerator.powerOn();
+        envelopeGenerator.powerOn();
     }
 };
 
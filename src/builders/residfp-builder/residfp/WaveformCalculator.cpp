@@ -209,4 +209,24 @@ matrix_t* WaveformCalculator::buildPulldownTable(ChipModel model)
 #endif
 }
 
+size_t WaveformCalculator::getMemoryUsage()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(PULLDOWN_CACHE_Lock);
+#endif
+
+    // The waveform table is always built before the first pulldown table
+    if (PULLDOWN_CACHE.empty())
+        return 0;
+
+    size_t size = getInstance()->wftable.length() * sizeof(short);
+
+    for (cw_cache_t::const_iterator it = PULLDOWN_CACHE.begin(); it != PULLDOWN_CACHE.end(); ++it)
+    {
+        size += it->second.length() * sizeof(short);
+    }
+
+    return size;
+}
+
 } // namespace reSIDfp
@@ -22,6 +22,8 @@
 #ifndef WAVEFORMCALCULATOR_h
 #define WAVEFORMCALCULATOR_h
 
+#include <cstddef>
+
 #include "array.h"
 
 #include "siddefs-fp.h"
@@ -122,6 +124,11 @@ public:
      * @return Pulldown table
      */
     matrix_t* buildPulldownTable(ChipModel model);
+
+    /**
+     * Get the memory used by the waveform and pulldown tables, in bytes.
+     */
+    static size_t getMemoryUsage();
 };
 
 } // namespace reSIDfp
@@ -450,6 +450,16 @@ void WaveformGenerator::shiftregBitfade()
         shift_register_reset = is6581 ? SHIFT_REGISTER_FADE_6581R3 : SHIFT_REGISTER_FADE_8580R5;
 }
 
+void WaveformGenerator::powerOn()
+{
+    accumulator = 0x555555;
+    tri_saw_pipeline = 0x555;
+    noise_output = 0;
+    no_noise_or_noise_output = 0;
+
+    reset();
+}
+
 void WaveformGenerator::reset()
 {
     // accumulator is not changed on reset
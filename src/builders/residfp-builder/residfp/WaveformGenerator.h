@@ -263,6 +263,12 @@ public:
      */
     void reset();
 
+    /**
+     * Bring the generator to the power-on state,
+     * including the accumulator which survives a reset.
+     */
+    void powerOn();
+
     /**
      * 12-bit waveform output.
      *
@@ -0,0 +1,391 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+/*
+ * Microbenchmarks for the reSIDfp hot paths.
+ *
+ * Each component is set up with typical register values
+ * and clocked for a fixed number of cycles, the time per cycle
+ * is reported together with the cache misses per thousand cycles
+ * when the hardware counters are available.
+ *
+ * Usage: bench [cycles]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+#  include <cstring>
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "siddefs-fp.h"
+
+#include "Dac.h"
+#include "EnvelopeGenerator.h"
+#include "Filter6581.h"
+#include "Filter8580.h"
+#include "FilterModelConfig6581.h"
+#include "FilterModelConfig8580.h"
+#include "Integrator6581.h"
+#include "SID.h"
+#include "Voice.h"
+#include "WaveformCalculator.h"
+#include "WaveformGenerator.h"
+#include "resample/SincResampler.h"
+
+#include "sidcxx11.h"
+
+using namespace reSIDfp;
+
+namespace
+{
+
+const double CLOCK_FREQ = 985248.;
+
+/// Keeps the results alive
+volatile int sink;
+
+/**
+ * Cache miss counter, a no-op where perf_event is not available.
+ */
+class cacheMisses
+{
+private:
+    int fd;
+
+public:
+    cacheMisses() :
+        fd(-1)
+    {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~cacheMisses()
+    {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        if (fd != -1)
+            close(fd);
+#endif
+    }
+
+    bool available() const { return fd != -1; }
+
+    void start()
+    {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long stop()
+    {
+        long long count = 0;
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+#endif
+        return count;
+    }
+};
+
+cacheMisses counter;
+
+clock_t startTime;
+
+void start()
+{
+    startTime = clock();
+    counter.start();
+}
+
+void stop(const char *name, unsigned int cycles)
+{
+    const long long misses = counter.stop();
+    const double ns = (clock() - startTime) * 1e9 / CLOCKS_PER_SEC;
+
+    if (counter.available())
+        printf("%-28s %8.2f ns/cycle %10.3f misses/kcycle\n", name, ns / cycles, misses * 1000. / cycles);
+    else
+        printf("%-28s %8.2f ns/cycle %10s misses/kcycle\n", name, ns / cycles, "n/a");
+}
+
+void setupWaveform(WaveformGenerator &wave, ChipModel model, unsigned char control)
+{
+    wave.setModel(model == MOS6581);
+    wave.setWaveformModels(WaveformCalculator::getInstance()->getWaveTable());
+    wave.setPulldownModels(WaveformCalculator::getInstance()->buildPulldownTable(model));
+    wave.reset();
+    wave.writeFREQ_LO(0x2b);
+    wave.writeFREQ_HI(0x1c);
+    wave.writePW_LO(0x00);
+    wave.writePW_HI(0x08);
+    wave.writeCONTROL_REG(control);
+}
+
+void benchWaveform(const char *name, unsigned char control, unsigned int cycles)
+{
+    WaveformGenerator wave;
+    setupWaveform(wave, MOS6581, control);
+
+    unsigned int sum = 0;
+    start();
+    for (unsigned int i = 0; i < cycles; i++)
+    {
+        wave.clock();
+        sum += wave.output(&wave);
+    }
+    stop(name, cycles);
+    sink = sum;
+}
+
+void benchEnvelope(unsigned int cycles)
+{
+    EnvelopeGenerator envelope;
+    envelope.reset();
+    envelope.writeATTACK_DECAY(0x22);
+    envelope.writeSUSTAIN_RELEASE(0x84);
+
+    unsigned int sum = 0;
+    start();
+    for (unsigned int i = 0; i < cycles; i++)
+    {
+        // Retrigger every 20ms to go through all the phases
+        if ((i % 19656) == 0)
+            envelope.writeCONTROL_REG(0x01);
+        else if ((i % 19656) == 9828)
+            envelope.writeCONTROL_REG(0x00);
+
+        envelope.clock();
+        sum += envelope.output();
+    }
+    stop("EnvelopeGenerator::clock", cycles);
+    sink = sum;
+}
+
+/**
+ * Record the output of three voices playing a chord.
+ */
+std::vector<int> voiceInputs(ChipModel model, unsigned int size)
+{
+    int oscDAC[1 << OSC_DAC_BITS];
+    int64_t envDAC[1 << ENV_DAC_BITS];
+    buildVoiceDacs(model, oscDAC, envDAC);
+
+    const unsigned char controls[3] = { 0x41, 0x21, 0x11 };
+
+    Voice voice[3];
+    for (int i = 0; i < 3; i++)
+    {
+        voice[i].setEnvDAC(envDAC);
+        voice[i].setWavDAC(oscDAC);
+        setupWaveform(*voice[i].wave(), model, 0x00);
+        voice[i].wave()->writeFREQ_HI(0x1c + i * 7);
+        voice[i].envelope()->reset();
+        voice[i].envelope()->writeATTACK_DECAY(0x00);
+        voice[i].envelope()->writeSUSTAIN_RELEASE(0xf0);
+        voice[i].writeCONTROL_REG(controls[i]);
+    }
+
+    std::vector<int> inputs(size * 3);
+    for (unsigned int i = 0; i < size; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            voice[j].wave()->clock();
+            voice[j].envelope()->clock();
+        }
+        inputs[i * 3 + 0] = voice[0].output(voice[2].wave());
+        inputs[i * 3 + 1] = voice[1].output(voice[0].wave());
+        inputs[i * 3 + 2] = voice[2].output(voice[1].wave());
+    }
+    return inputs;
+}
+
+template<class T>
+void benchFilter(const char *name, T &filter, ChipModel model, unsigned int cycles)
+{
+    // Skip the attack phase
+    const unsigned int size = 1 << 16;
+    const std::vector<int> inputs = voiceInputs(model, size * 2);
+
+    filter.reset();
+    filter.writeFC_LO(0x07);
+    filter.writeFC_HI(0x40);
+    filter.writeRES_FILT(0xf7);
+    filter.writeMODE_VOL(0x1f);
+
+    unsigned int sum = 0;
+    start();
+    for (unsigned int i = 0; i < cycles; i++)
+    {
+        const int *v = &inputs[(size + (i & (size - 1))) * 3];
+        sum += filter.clock(v[0], v[1], v[2]);
+    }
+    stop(name, cycles);
+    sink = sum;
+}
+
+void benchIntegrator(unsigned int cycles)
+{
+    FilterModelConfig6581 *fmc = FilterModelConfig6581::getInstance();
+    Integrator6581 integrator = fmc->buildIntegrator();
+
+    std::vector<unsigned short> f0_dac(1 << FilterModelConfig6581::DAC_BITS);
+    fmc->getDAC(0.5, &f0_dac[0]);
+    integrator.setVw(f0_dac[0x200]);
+
+    // A slow triangle within the range seen by the filter
+    const unsigned int size = 1 << 12;
+    std::vector<int> inputs(size);
+    for (unsigned int i = 0; i < size; i++)
+    {
+        const int tri = i < size / 2 ? i : size - i;
+        inputs[i] = 0x5000 + tri * 4;
+    }
+
+    int sum = 0;
+    start();
+    for (unsigned int i = 0; i < cycles; i++)
+    {
+        sum += integrator.solve(inputs[i & (size - 1)]);
+    }
+    stop("Integrator6581::solve", cycles);
+    sink = sum;
+}
+
+void benchResampler(unsigned int cycles)
+{
+    SincResampler resampler(CLOCK_FREQ, 48000., 20000.);
+
+    int sum = 0;
+    start();
+    for (unsigned int i = 0; i < cycles; i++)
+    {
+        if (resampler.input(static_cast<short>(i * 97)))
+            sum += resampler.output();
+    }
+    stop("SincResampler::input", cycles);
+    sink = sum;
+}
+
+void benchSID(const char *name, ChipModel model, unsigned int cycles)
+{
+    SID sid;
+    sid.setChipModel(model);
+    sid.setSamplingParameters(CLOCK_FREQ, RESAMPLE, 48000., 20000.);
+    sid.reset();
+
+    // Three voices playing a chord through the filter
+    const unsigned char regs[] =
+    {
+        0x2b, 0x1c, 0x00, 0x08, 0x41, 0x22, 0x84,
+        0xd6, 0x23, 0x00, 0x04, 0x21, 0x22, 0x84,
+        0x5a, 0x2a, 0x00, 0x08, 0x11, 0x22, 0x84,
+        0x07, 0x40, 0xf7, 0x1f
+    };
+    for (int i = 0; i < static_cast<int>(sizeof(regs)); i++)
+    {
+        sid.write(i, regs[i]);
+    }
+
+    // One frame at a time, as the player does
+    const unsigned int frame = 19656;
+    std::vector<short> buffer(frame * 48000 / 985248 + 16);
+
+    const unsigned int frames = (cycles + frame - 1) / frame;
+
+    int sum = 0;
+    start();
+    for (unsigned int i = 0; i < frames; i++)
+    {
+        const int samples = sid.clock(frame, &buffer[0]);
+        sum += buffer[samples - 1];
+    }
+    stop(name, frames * frame);
+    sink = sum;
+}
+
+}
+
+int main(int argc, const char* argv[])
+{
+    const unsigned int cycles = argc > 1 ? atoi(argv[1]) : 10000000;
+
+    // Build the shared tables before measuring
+    FilterModelConfig6581::getInstance();
+    FilterModelConfig8580::getInstance();
+
+    benchWaveform("WaveformGenerator triangle", 0x11, cycles);
+    benchWaveform("WaveformGenerator sawtooth", 0x21, cycles);
+    benchWaveform("WaveformGenerator pulse", 0x41, cycles);
+    benchWaveform("WaveformGenerator noise", 0x81, cycles);
+    benchWaveform("WaveformGenerator combined", 0x61, cycles);
+
+    benchEnvelope(cycles);
+
+    {
+        std::unique_ptr<Filter6581> filter(new Filter6581());
+        benchFilter("Filter6581::clock", *filter, MOS6581, cycles);
+    }
+    {
+        std::unique_ptr<Filter8580> filter(new Filter8580());
+        benchFilter("Filter8580::clock", *filter, MOS8580, cycles);
+    }
+
+    benchIntegrator(cycles);
+
+    benchResampler(cycles);
+
+    benchSID("SID::clock 6581", MOS6581, cycles);
+    benchSID("SID::clock 8580", MOS8580, cycles);
+
+    return 0;
+}
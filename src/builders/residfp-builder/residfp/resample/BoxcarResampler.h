@@ -0,0 +1,100 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef BOXCAR_RESAMPLER_H
+#define BOXCAR_RESAMPLER_H
+
+#include <cmath>
+
+#include "Resampler.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Decimate by an integer factor averaging consecutive samples.
+ *
+ * The output rate is clockFrequency / factor where factor is
+ * the ratio between the clock and sampling frequencies rounded
+ * to the nearest integer. With a factor of one the samples
+ * are passed through unchanged.
+ * The moving average is only a rough anti-aliasing filter,
+ * callers are expected to apply their own resampling.
+ */
+class BoxcarResampler final : public Resampler
+{
+
+private:
+    /// Number of cycles per sample
+    const int factor;
+
+    /// Cycles left before the next sample
+    int count;
+
+    /// Running sum
+    int sum;
+
+    /// Calculated sample
+    int outputValue;
+
+private:
+    static int decimationFactor(double clockFrequency, double samplingFrequency)
+    {
+        const int ratio = static_cast<int>(std::floor(clockFrequency / samplingFrequency + 0.5));
+        return ratio > 1 ? ratio : 1;
+    }
+
+public:
+    BoxcarResampler(double clockFrequency, double samplingFrequency) :
+        factor(decimationFactor(clockFrequency, samplingFrequency)),
+        count(factor),
+        sum(0),
+        outputValue(0) {}
+
+    bool input(int sample) override
+    {
+        sum += sample;
+
+        if (likely(--count != 0))
+            return false;
+
+        outputValue = sum / factor;
+        sum = 0;
+        count = factor;
+        return true;
+    }
+
+    int output() const override { return outputValue; }
+
+    void reset() override
+    {
+        count = factor;
+        sum = 0;
+        outputValue = 0;
+    }
+
+    size_t getMemoryUsage() const override { return sizeof(BoxcarResampler); }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CICRESAMPLER_H
+#define CICRESAMPLER_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+
+#include "Resampler.h"
+#include "SincResampler.h"
+
+#include "sidcxx11.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Cheap anti-aliased resampling.
+ *
+ * A fourth order CIC filter decimates the input by an integer factor
+ * to roughly three times the sampling frequency, then a short
+ * SincResampler with a relaxed passband produces the output.
+ * The CIC costs a few additions per cycle and the images folding
+ * into the passband are attenuated by more than 60 dB, at the price
+ * of a small droop at the top of the passband.
+ */
+class CicResampler final : public Resampler
+{
+private:
+    /// CIC filter order
+    static const int ORDER = 4;
+
+private:
+    SincResampler sinc;
+
+    /// Decimation factor
+    const int factor;
+
+    /// Inverse of the CIC gain, factor^ORDER
+    const double scale;
+
+    int count;
+
+    /// Integrators and comb delays, wrapping arithmetic is intended
+    //@{
+    uint64_t integrator[ORDER];
+    uint64_t comb[ORDER];
+    //@}
+
+private:
+    CicResampler(double clockFrequency, double samplingFrequency, double highestAccurateFrequency, int decimation) :
+        sinc(clockFrequency / decimation, samplingFrequency, highestAccurateFrequency),
+        factor(decimation),
+        scale(1. / pow(static_cast<double>(decimation), ORDER)),
+        count(decimation)
+    {
+        reset();
+    }
+
+public:
+    // Named constructor
+    static CicResampler* create(double clockFrequency, double samplingFrequency, double highestAccurateFrequency,
+        Allocator *allocator = nullptr)
+    {
+        // Keep the intermediate rate high enough that the first CIC null
+        // is well above the stopband of the sinc stage.
+        const int decimation = static_cast<int>(clockFrequency / (3. * samplingFrequency));
+
+        // The transition band is widened to keep the filter short.
+        const double passFrequency = std::min(highestAccurateFrequency, 0.35 * samplingFrequency);
+
+        return new (allocator) CicResampler(clockFrequency, samplingFrequency, passFrequency, decimation > 1 ? decimation : 1);
+    }
+
+    bool input(int sample) override
+    {
+        uint64_t value = static_cast<uint64_t>(static_cast<int64_t>(sample));
+        for (int i = 0; i < ORDER; i++)
+        {
+            integrator[i] += value;
+            value = integrator[i];
+        }
+
+        if (likely(--count != 0))
+            return false;
+
+        count = factor;
+
+        for (int i = 0; i < ORDER; i++)
+        {
+            const uint64_t delayed = comb[i];
+            comb[i] = value;
+            value -= delayed;
+        }
+
+        const double decimated = static_cast<double>(static_cast<int64_t>(value)) * scale;
+        return sinc.input(static_cast<int>(std::floor(decimated + 0.5)));
+    }
+
+    int output() const override
+    {
+        return sinc.output();
+    }
+
+    void reset() override
+    {
+        count = factor;
+        for (int i = 0; i < ORDER; i++)
+        {
+            integrator[i] = 0;
+            comb[i] = 0;
+        }
+        sinc.reset();
+    }
+
+    size_t getMemoryUsage() const override { return sizeof(CicResampler); }
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -23,7 +23,9 @@
 #define RESAMPLER_H
 
 #include <cmath>
+#include <cstddef>
 
+#include "../Allocated.h"
 #include "sidcxx11.h"
 
 #include "siddefs-fp.h"
@@ -35,7 +37,7 @@ namespace reSIDfp
  * Abstraction of a resampling process. Given enough input, produces output.
  * Constructors take additional arguments that configure these objects.
  */
-class Resampler
+class Resampler : public Allocated
 {
 protected:
     inline short softClip(int x) const
@@ -78,7 +80,23 @@ public:
         return softClip(output());
     }
 
+    /**
+     * Output a sample from resampler without clipping.
+     *
+     * @return resampled sample, full scale is 1.0
+     */
+    float getFloatOutput() const
+    {
+        return static_cast<float>(output()) * (1.f / 32768.f);
+    }
+
     virtual void reset() = 0;
+
+    /**
+     * Get the memory owned by the resampler, in bytes.
+     * Shared tables are not included.
+     */
+    virtual size_t getMemoryUsage() const = 0;
 };
 
 } // namespace reSIDfp
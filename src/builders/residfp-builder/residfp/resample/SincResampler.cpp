@@ -101,43 +101,25 @@ double I0(double x)
 int convolve(const short* a, const short* b, int bLength)
 {
 #ifdef HAVE_EMMINTRIN_H
-    int out = 0;
+    __m128i acc = _mm_setzero_si128();
 
-    const uintptr_t offset = (uintptr_t)(a) & 0x0f;
+    const int n = bLength / 8;
 
-    // check for aligned accesses
-    if (offset == ((uintptr_t)(b) & 0x0f))
+    for (int i = 0; i < n; i++)
     {
-        if (offset)
-        {
-            const int l = (0x10 - offset)/2;
-
-            for (int i = 0; i < l; i++)
-            {
-                out += *a++ * *b++;
-            }
-
-            bLength -= offset;
-        }
-
-        __m128i acc = _mm_setzero_si128();
-
-        const int n = bLength / 8;
-
-        for (int i = 0; i < n; i++)
-        {
-            const __m128i tmp = _mm_madd_epi16(*(__m128i*)a, *(__m128i*)b);
-            acc = _mm_add_epi16(acc, tmp);
-            a += 8;
-            b += 8;
-        }
+        // The sample window can start anywhere in the ring buffer
+        const __m128i va = _mm_loadu_si128((const __m128i*)a);
+        const __m128i vb = _mm_loadu_si128((const __m128i*)b);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+        a += 8;
+        b += 8;
+    }
 
-        __m128i vsum = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
-        vsum = _mm_add_epi32(vsum, _mm_srli_si128(vsum, 4));
-        out += _mm_cvtsi128_si32(vsum);
+    __m128i vsum = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+    vsum = _mm_add_epi32(vsum, _mm_srli_si128(vsum, 4));
+    int out = _mm_cvtsi128_si32(vsum);
 
-        bLength &= 7;
-    }
+    bLength &= 7;
 #elif defined HAVE_MMINTRIN_H
     __m64 acc = _mm_setzero_si64();
 
@@ -146,7 +128,7 @@ int convolve(const short* a, const short* b, int bLength)
     for (int i = 0; i < n; i++)
     {
         const __m64 tmp = _mm_madd_pi16(*(__m64*)a, *(__m64*)b);
-        acc = _mm_add_pi16(acc, tmp);
+        acc = _mm_add_pi32(acc, tmp);
         a += 4;
         b += 4;
     }
@@ -247,6 +229,19 @@ int convolve(const short* a, const short* b, int bLength)
     return (out + (1 << 14)) >> 15;
 }
 
+int SincResampler::firPhase(int phase, int sampleStart) const
+{
+    if (phase <= firRES / 2)
+    {
+        return convolve(sample + sampleStart, (*firTable)[phase], firNpadded);
+    }
+
+    // Upper phases are the time reversal of the lower ones:
+    // walk the samples backwards starting from the most recent one.
+    const int reversedStart = (RINGSIZE - sampleIndex) & (RINGSIZE - 1);
+    return convolve(sampleReversed + reversedStart, (*firTable)[firRES - phase], firNpadded);
+}
+
 int SincResampler::fir(int subcycle)
 {
     // Find the first of the nearest fir tables close to the phase
@@ -256,7 +251,7 @@ int SincResampler::fir(int subcycle)
     // Find firN most recent samples, plus one extra in case the FIR wraps.
     int sampleStart = sampleIndex - firN + RINGSIZE - 1;
 
-    const int v1 = convolve(sample + sampleStart, (*firTable)[firTableFirst], firN);
+    const int v1 = firPhase(firTableFirst, sampleStart);
 
     // Use next FIR table, wrap around to first FIR table using
     // previous sample.
@@ -266,7 +261,7 @@ int SincResampler::fir(int subcycle)
         ++sampleStart;
     }
 
-    const int v2 = convolve(sample + sampleStart, (*firTable)[firTableFirst], firN);
+    const int v2 = firPhase(firTableFirst, sampleStart);
 
     // Linear interpolation between the sinc tables yields good
     // approximation for the exact value.
@@ -306,8 +301,10 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
         firN = static_cast<int>(N * cyclesPerSampleD) + 1;
         firN |= 1;
 
+        firNpadded = (firN + FIR_STEP - 1) & ~(FIR_STEP - 1);
+
         // Check whether the sample ring buffer would overflow.
-        assert(firN < RINGSIZE);
+        assert(firNpadded < RINGSIZE);
 
         // Error is bounded by err < 1.234 / L^2, so L = sqrt(1.234 / (2^-16)) = sqrt(1.234 * 2^16).
         firRES = static_cast<int>(ceil(sqrt(1.234 * (1 << BITS)) / cyclesPerSampleD));
@@ -337,7 +334,9 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
     else
     {
         // Allocate memory for FIR tables.
-        matrix_t tempTable(firRES, firN);
+        // Only the phases up to firRES/2 are needed, the others are mirrored.
+        const int firRows = firRES / 2 + 1;
+        matrix_t tempTable(firRows, firNpadded);
 #ifdef HAVE_CXX11
         firTable = &(FIR_CACHE.emplace_hint(lb, fir_cache_t::value_type(firKey, tempTable))->second);
 #else
@@ -355,7 +354,7 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
         const int tmp = firN / 2;
         const double firN_2 = static_cast<double>(tmp);
 
-        for (int i = 0; i < firRES; i++)
+        for (int i = 0; i < firRows; i++)
         {
             const double jPhase = (double) i / firRES + firN_2;
 
@@ -371,6 +370,11 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
 
                 (*firTable)[i][j] = static_cast<short>(scale * sincWt * kaiserXt);
             }
+
+            for (int j = firN; j < firNpadded; j++)
+            {
+                (*firTable)[i][j] = 0;
+            }
         }
     }
 }
@@ -386,7 +390,10 @@ bool SincResampler::input(int input)
      * 6581: [-24262,+25080]  (Kawasaki_Synthesizer_Demo)
      * 8580: [-21514,+35232]  (64_Forever, Drum_Fool)
      */
-    sample[sampleIndex] = sample[sampleIndex + RINGSIZE] = softClip(input);
+    const short value = softClip(input);
+    sample[sampleIndex] = sample[sampleIndex + RINGSIZE] = value;
+    const int reversedIndex = RINGSIZE - 1 - sampleIndex;
+    sampleReversed[reversedIndex] = sampleReversed[reversedIndex + RINGSIZE] = value;
     sampleIndex = (sampleIndex + 1) & (RINGSIZE - 1);
 
     if (sampleOffset < 1024)
@@ -404,7 +411,24 @@ bool SincResampler::input(int input)
 void SincResampler::reset()
 {
     memset(sample, 0, sizeof(sample));
+    memset(sampleReversed, 0, sizeof(sampleReversed));
     sampleOffset = 0;
 }
 
+size_t SincResampler::getCacheMemoryUsage()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(FIR_CACHE_Lock);
+#endif
+
+    size_t size = 0;
+
+    for (fir_cache_t::const_iterator it = FIR_CACHE.begin(); it != FIR_CACHE.end(); ++it)
+    {
+        size += it->first.size() + it->second.length() * sizeof(short);
+    }
+
+    return size;
+}
+
 } // namespace reSIDfp
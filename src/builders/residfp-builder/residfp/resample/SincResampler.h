@@ -49,6 +49,12 @@ namespace reSIDfp
  * this implementation dramatically reduces the computational effort in the
  * filter convolutions, without any loss of accuracy.
  * The filter convolutions are also vectorizable on current hardware.
+ *
+ * Phase i of the windowed sinc is the time reversal of phase firRES - i,
+ * so only the first half of the phases is stored. The remaining ones are
+ * convolved against a time reversed copy of the sample ring buffer.
+ * Each table row is padded with zero taps to a multiple of FIR_STEP
+ * so that the convolution runs on whole SIMD blocks without a scalar tail.
  */
 class SincResampler final : public Resampler
 {
@@ -56,8 +62,11 @@ private:
     /// Size of the ring buffer, must be a power of 2
     static const int RINGSIZE = 2048;
 
+    /// Row padding of the FIR table, in taps
+    static const int FIR_STEP = 8;
+
 private:
-    /// Table of the fir filter coefficients
+    /// Table of the fir filter coefficients, phases 0 to firRES/2
     matrix_t* firTable;
 
     int sampleIndex;
@@ -68,15 +77,23 @@ private:
     /// Filter length
     int firN;
 
+    /// Filter length padded to a multiple of FIR_STEP
+    int firNpadded;
+
     const int cyclesPerSample;
 
     int sampleOffset;
 
     int outputValue;
 
-    short sample[RINGSIZE * 2];
+    short sample[RINGSIZE * 2 + FIR_STEP];
+
+    /// Same as sample but in reversed time order
+    short sampleReversed[RINGSIZE * 2];
 
 private:
+    int firPhase(int phase, int sampleStart) const;
+
     int fir(int subcycle);
 
 public:
@@ -107,6 +124,13 @@ public:
     int output() const override { return outputValue; }
 
     void reset() override;
+
+    size_t getMemoryUsage() const override { return sizeof(SincResampler); }
+
+    /**
+     * Get the memory used by the cached FIR tables, in bytes.
+     */
+    static size_t getCacheMemoryUsage();
 };
 
 } // namespace reSIDfp
@@ -24,8 +24,6 @@
 
 #include <cmath>
 
-#include <memory>
-
 #include "Resampler.h"
 #include "SincResampler.h"
 
@@ -40,41 +38,47 @@ namespace reSIDfp
 class TwoPassSincResampler final : public Resampler
 {
 private:
-    std::unique_ptr<SincResampler> const s1;
-    std::unique_ptr<SincResampler> const s2;
+    SincResampler s1;
+    SincResampler s2;
 
 private:
     TwoPassSincResampler(double clockFrequency, double samplingFrequency, double highestAccurateFrequency, double intermediateFrequency) :
-        s1(new SincResampler(clockFrequency, intermediateFrequency, highestAccurateFrequency)),
-        s2(new SincResampler(intermediateFrequency, samplingFrequency, highestAccurateFrequency))
+        s1(clockFrequency, intermediateFrequency, highestAccurateFrequency),
+        s2(intermediateFrequency, samplingFrequency, highestAccurateFrequency)
     {}
 
 public:
     // Named constructor
-    static TwoPassSincResampler* create(double clockFrequency, double samplingFrequency, double highestAccurateFrequency)
+    static TwoPassSincResampler* create(double clockFrequency, double samplingFrequency, double highestAccurateFrequency,
+        Allocator *allocator = nullptr)
     {
         // Calculation according to Laurent Ganier. It evaluates to about 120 kHz at typical settings.
         // Some testing around the chosen value seems to confirm that this does work.
         double const intermediateFrequency = 2. * highestAccurateFrequency
             + sqrt(2. * highestAccurateFrequency * clockFrequency
                 * (samplingFrequency - 2. * highestAccurateFrequency) / samplingFrequency);
-        return new TwoPassSincResampler(clockFrequency, samplingFrequency, highestAccurateFrequency, intermediateFrequency);
+        return new (allocator) TwoPassSincResampler(clockFrequency, samplingFrequency, highestAccurateFrequency, intermediateFrequency);
     }
 
     bool input(int sample) override
     {
-        return s1->input(sample) && s2->input(s1->output());
+        return s1.input(sample) && s2.input(s1.output());
     }
 
     int output() const override
     {
-        return s2->output();
+        return s2.output();
     }
 
     void reset() override
     {
-        s1->reset();
-        s2->reset();
+        s1.reset();
+        s2.reset();
+    }
+
+    size_t getMemoryUsage() const override
+    {
+        return sizeof(TwoPassSincResampler);
     }
 };
 
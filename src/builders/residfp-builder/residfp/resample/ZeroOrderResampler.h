@@ -81,6 +81,8 @@ public:
         sampleOffset = 0;
         cachedSample = 0;
     }
+
+    size_t getMemoryUsage() const override { return sizeof(ZeroOrderResampler); }
 };
 
 } // namespace reSIDfp
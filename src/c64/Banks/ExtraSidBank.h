@@ -58,7 +58,7 @@ private:
     sids_t sids;
 
 private:
-    static void resetSID(sids_t::value_type &e) { e->reset(0xf); }
+    static void resetSID(sids_t::value_type &e) { e->clearStatus(); e->reset(0xf); }
 
     static unsigned int mapperIndex(int address) { return address >> 5 & (MAPPER_SIZE - 1); }
 
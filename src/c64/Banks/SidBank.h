@@ -50,6 +50,7 @@ public:
 
     void reset()
     {
+        sid->clearStatus();
         sid->reset(0xf);
     }
 
@@ -0,0 +1,146 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2012-2021 Leandro Nini <drfiemost@users.sourceforge.net>
+ * Copyright 2010 Antti Lankila
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SystemRAMBank.h"
+
+#include <algorithm>
+
+namespace libsidplayfp
+{
+
+/**
+ * The RAM powerup pattern.
+ */
+class powerOnPattern
+{
+public:
+    uint8_t ram[0x10000];
+
+public:
+    powerOnPattern()
+    {
+        uint8_t byte = 0x00;
+        for (int j=0x0000; j<0x10000; j+=0x4000)
+        {
+            memset(ram+j, byte, 0x4000);
+            byte = ~byte;
+            for (int i = 0x02; i < 0x4000; i += 0x08)
+            {
+                memset(ram+j+i, byte, 0x04);
+            }
+        }
+    }
+};
+
+const uint8_t* SystemRAMBank::powerOnImage()
+{
+    // Constructed on first use, the banks
+    // may live in static objects too
+    static const powerOnPattern pattern;
+    return pattern.ram;
+}
+
+#ifdef SLIM_ENGINE
+
+SystemRAMBank::SystemRAMBank() :
+    poolUsed(0),
+    allocator(nullptr)
+{
+    reset();
+}
+
+SystemRAMBank::~SystemRAMBank()
+{
+    for (std::vector<uint8_t*>::iterator it = pool.begin(); it != pool.end(); ++it)
+        allocated::release(*it);
+}
+
+void SystemRAMBank::reset()
+{
+    const uint8_t* image = powerOnImage();
+    for (unsigned int i = 0; i < 0x100; i++)
+    {
+        readPages[i] = image + (i << 8);
+        writePages[i] = nullptr;
+    }
+
+    poolUsed = 0;
+}
+
+uint8_t* SystemRAMBank::copyPage(unsigned int page)
+{
+    if (poolUsed == pool.size())
+        pool.push_back(static_cast<uint8_t*>(allocated::allocate(0x100, allocator)));
+
+    uint8_t* copy = pool[poolUsed++];
+    memcpy(copy, readPages[page], 0x100);
+    readPages[page] = writePages[page] = copy;
+    return copy;
+}
+
+void SystemRAMBank::fill(uint_least16_t start, uint8_t value, unsigned int size)
+{
+    unsigned int address = start;
+    while (size != 0)
+    {
+        const unsigned int offset = address & 0xff;
+        const unsigned int count = std::min(size, 0x100 - offset);
+
+        uint8_t* page = writePages[address >> 8];
+        if (page == nullptr)
+            page = copyPage(address >> 8);
+        memset(page + offset, value, count);
+
+        address = (address + count) & 0xffff;
+        size -= count;
+    }
+}
+
+void SystemRAMBank::fill(uint_least16_t start, const uint8_t* source, unsigned int size)
+{
+    unsigned int address = start;
+    while (size != 0)
+    {
+        const unsigned int offset = address & 0xff;
+        const unsigned int count = std::min(size, 0x100 - offset);
+
+        uint8_t* page = writePages[address >> 8];
+        if (page == nullptr)
+            page = copyPage(address >> 8);
+        memcpy(page + offset, source, count);
+
+        source += count;
+        address = (address + count) & 0xffff;
+        size -= count;
+    }
+}
+
+#else
+
+void SystemRAMBank::reset()
+{
+    memcpy(ram, powerOnImage(), sizeof(ram));
+}
+
+#endif
+
+}
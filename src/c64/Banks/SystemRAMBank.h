@@ -23,29 +23,72 @@
 #define SYSTEMRAMBANK_H
 
 #include <stdint.h>
+#include <cstddef>
 #include <cstring>
 
 #include "Bank.h"
+#include "allocator.h"
+#include "sidendian.h"
 
 #include "sidcxx11.h"
 
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef SLIM_ENGINE
+#  include <vector>
+#endif
+
 namespace libsidplayfp
 {
 
 /**
  * Area backed by RAM.
+ *
+ * Slim builds keep the RAM in 256 byte pages which point
+ * to a shared power-on image until first written, so that
+ * a reset only remaps the pages and the memory is only
+ * allocated for the pages actually touched.
  */
 class SystemRAMBank final : public Bank
 {
-    friend class MMU;
-
 private:
+#ifdef SLIM_ENGINE
+    /// Pages for reading, the shared image until written
+    const uint8_t* readPages[0x100];
+
+    /// Private pages, null until written
+    uint8_t* writePages[0x100];
+
+    /// Allocated private pages, reused after reset
+    std::vector<uint8_t*> pool;
+
+    /// Number of private pages in use
+    unsigned int poolUsed;
+
+    /// Where the private pages are placed
+    const SidAllocator* allocator;
+#else
     /// C64 RAM area
     uint8_t ram[0x10000];
+#endif
+
+private:
+#ifdef SLIM_ENGINE
+    /**
+     * Get a private copy of a page.
+     */
+    uint8_t* copyPage(unsigned int page);
+
+    // prevent copying
+    SystemRAMBank(const SystemRAMBank&);
+    SystemRAMBank& operator=(const SystemRAMBank&);
+#endif
 
 public:
     /**
-     * Initialize RAM with powerup pattern.
+     * Get the RAM powerup pattern, shared by all the banks.
      *
      * $0000: 00 00 ff ff ff ff 00 00 00 00 ff ff ff ff 00 00
      * ...
@@ -55,20 +98,61 @@ public:
      * ...
      * $c000: ff ff 00 00 00 00 ff ff ff ff 00 00 00 00 ff ff
      */
-    void reset()
+    static const uint8_t* powerOnImage();
+
+    /**
+     * Get the size of the powerup pattern, in bytes.
+     */
+    static size_t powerOnImageSize() { return 0x10000; }
+
+public:
+#ifdef SLIM_ENGINE
+    SystemRAMBank();
+    ~SystemRAMBank();
+
+    void setAllocator(const SidAllocator* alloc) { allocator = alloc; }
+#else
+    void setAllocator(const SidAllocator*) {}
+#endif
+
+    /**
+     * Initialize RAM with powerup pattern.
+     */
+    void reset();
+
+#ifdef SLIM_ENGINE
+    uint8_t peek(uint_least16_t address) override
+    {
+        return readPages[address >> 8][address & 0xff];
+    }
+
+    void poke(uint_least16_t address, uint8_t value) override
     {
-        uint8_t byte = 0x00;
-        for (int j=0x0000; j<0x10000; j+=0x4000)
-        {
-            memset(ram+j, byte, 0x4000);
-            byte = ~byte;
-            for (int i = 0x02; i < 0x4000; i += 0x08)
-            {
-                memset(ram+j+i, byte, 0x04);
-            }
-        }
+        uint8_t* page = writePages[address >> 8];
+        if (page == nullptr)
+            page = copyPage(address >> 8);
+        page[address & 0xff] = value;
     }
 
+    uint_least16_t readWord(uint_least16_t address)
+    {
+        return endian_16(peek(address + 1), peek(address));
+    }
+
+    void writeWord(uint_least16_t address, uint_least16_t value)
+    {
+        poke(address, endian_16lo8(value));
+        poke(address + 1, endian_16hi8(value));
+    }
+
+    void fill(uint_least16_t start, uint8_t value, unsigned int size);
+    void fill(uint_least16_t start, const uint8_t* source, unsigned int size);
+
+    /**
+     * Get the memory owned by this bank, in bytes.
+     */
+    size_t pagesSize() const { return pool.size() * 0x100; }
+#else
     uint8_t peek(uint_least16_t address) override
     {
         return ram[address];
@@ -78,6 +162,29 @@ public:
     {
         ram[address] = value;
     }
+
+    uint_least16_t readWord(uint_least16_t address)
+    {
+        return endian_little16(ram+address);
+    }
+
+    void writeWord(uint_least16_t address, uint_least16_t value)
+    {
+        endian_little16(ram+address, value);
+    }
+
+    void fill(uint_least16_t start, uint8_t value, unsigned int size)
+    {
+        memset(ram+start, value, size);
+    }
+
+    void fill(uint_least16_t start, const uint8_t* source, unsigned int size)
+    {
+        memcpy(ram+start, source, size);
+    }
+
+    size_t pagesSize() const { return 0; }
+#endif
 };
 
 }
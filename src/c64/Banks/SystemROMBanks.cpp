@@ -0,0 +1,163 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2012-2022 Leandro Nini <drfiemost@users.sourceforge.net>
+ * Copyright 2010 Antti Lankila
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SystemROMBanks.h"
+
+#include <cassert>
+#include <list>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_CXX11
+#  include <mutex>
+#endif
+
+namespace libsidplayfp
+{
+
+namespace romImages
+{
+
+struct image_t
+{
+    uint8_t *data;
+    unsigned int size;
+    uint_least32_t hash;
+    unsigned int refs;
+};
+
+typedef std::list<image_t> images_t;
+
+// Constructed on first use, the banks
+// may live in static objects too
+static images_t& getImages()
+{
+    static images_t images;
+    return images;
+}
+
+#ifdef HAVE_CXX11
+static std::mutex& getLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+#endif
+
+static uint_least32_t fnv(const uint8_t* data, unsigned int size)
+{
+    uint_least32_t hash = 0x811c9dc5;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash = (hash * 0x01000193) & 0xffffffff;
+    }
+    return hash;
+}
+
+static images_t::iterator find(images_t &images, const uint8_t* image)
+{
+    images_t::iterator it = images.begin();
+    while (it != images.end() && it->data != image)
+        ++it;
+    return it;
+}
+
+const uint8_t* acquire(const uint8_t* source, unsigned int size)
+{
+    // A blank image is looked up as any other
+    std::vector<uint8_t> blank;
+    if (source == nullptr)
+    {
+        blank.resize(size, 0);
+        source = &blank[0];
+    }
+
+    const uint_least32_t hash = fnv(source, size);
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(getLock());
+#endif
+    images_t &images = getImages();
+    for (images_t::iterator it = images.begin(); it != images.end(); ++it)
+    {
+        if ((it->hash == hash) && (it->size == size) && (memcmp(it->data, source, size) == 0))
+        {
+            it->refs++;
+            return it->data;
+        }
+    }
+
+    image_t entry;
+    entry.data = new uint8_t[size];
+    entry.size = size;
+    entry.hash = hash;
+    entry.refs = 1;
+    memcpy(entry.data, source, size);
+    images.push_back(entry);
+
+    return entry.data;
+}
+
+void addRef(const uint8_t* image)
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(getLock());
+#endif
+    images_t &images = getImages();
+    images_t::iterator it = find(images, image);
+    assert(it != images.end());
+    it->refs++;
+}
+
+void release(const uint8_t* image)
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(getLock());
+#endif
+    images_t &images = getImages();
+    images_t::iterator it = find(images, image);
+    assert(it != images.end());
+    if (--it->refs == 0)
+    {
+        delete [] it->data;
+        images.erase(it);
+    }
+}
+
+size_t memoryUsage()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(getLock());
+#endif
+    images_t &images = getImages();
+    size_t bytes = 0;
+    for (images_t::const_iterator it = images.begin(); it != images.end(); ++it)
+        bytes += it->size;
+    return bytes;
+}
+
+}
+
+}
@@ -23,51 +23,207 @@
 #define SYSTEMROMBANKS_H
 
 #include <stdint.h>
+#include <cstddef>
 #include <cstring>
+#include <vector>
 
 #include "Bank.h"
+#include "allocator.h"
 #include "c64/CPU/opcodes.h"
+#include "sidendian.h"
 
 #include "sidcxx11.h"
 
 namespace libsidplayfp
 {
 
+/**
+ * Store of the ROM images shared among all the banks.
+ * Identical images are kept only once.
+ */
+namespace romImages
+{
+    /**
+     * Get the shared copy of an image.
+     *
+     * @param source the image, nullptr for a blank one
+     * @param size the image size
+     * @return the shared image
+     */
+    const uint8_t* acquire(const uint8_t* source, unsigned int size);
+
+    /**
+     * Add a reference to a shared image.
+     */
+    void addRef(const uint8_t* image);
+
+    /**
+     * Drop a reference to a shared image,
+     * the image is freed when no longer used.
+     */
+    void release(const uint8_t* image);
+
+    /**
+     * Get the memory used by the shared images, in bytes.
+     */
+    size_t memoryUsage();
+}
+
 /**
  * ROM bank base class.
+ *
+ * The content is a shared immutable image, reads go through a page table.
+ * Pages that get patched are copied into a private overlay,
+ * so each bank only owns the few pages it changes.
  */
 template <int N>
 class romBank : public Bank
 {
 #ifdef HAVE_CXX11
-    static_assert((N != 0) && ((N & (N - 1)) == 0), "N must be a power of two");
+    static_assert((N >= 0x100) && ((N & (N - 1)) == 0), "N must be a power of two");
 #endif
 
-protected:
-    /// The ROM array
-    uint8_t rom[N];
+private:
+    static const int PAGES = N >> 8;
+
+private:
+    /// The shared ROM image
+    const uint8_t* image;
+
+    /// Private copies of the patched pages, 256 bytes each
+    std::vector<uint8_t*> overlay;
+
+    /// Number of overlay pages in use
+    unsigned int overlayUsed;
+
+    /// Where the overlay pages are placed
+    const SidAllocator* allocator;
+
+    /// The page table
+    const uint8_t* pages[PAGES];
+
+private:
+    /**
+     * Point all the pages back to the shared image.
+     */
+    void mapImage()
+    {
+        for (int i = 0; i < PAGES; i++)
+            pages[i] = image + (i << 8);
+
+        overlayUsed = 0;
+    }
+
+    /**
+     * Get a writable copy of a page.
+     */
+    uint8_t* patchPage(unsigned int page)
+    {
+        for (unsigned int i = 0; i < overlayUsed; i++)
+        {
+            if (pages[page] == overlay[i])
+                return overlay[i];
+        }
+
+        if (overlayUsed == overlay.size())
+            overlay.push_back(static_cast<uint8_t*>(allocated::allocate(0x100, allocator)));
+
+        uint8_t* copy = overlay[overlayUsed++];
+        memcpy(copy, pages[page], 0x100);
+        pages[page] = copy;
+        return copy;
+    }
+
+    void copyPages(const romBank &other)
+    {
+        mapImage();
+
+        for (int i = 0; i < PAGES; i++)
+        {
+            if (other.pages[i] != other.image + (i << 8))
+                memcpy(patchPage(i), other.pages[i], 0x100);
+        }
+    }
 
 protected:
     /**
      * Set value at memory address.
      */
-    void setVal(uint_least16_t address, uint8_t val) { rom[address & (N-1)]=val; }
+    void setVal(uint_least16_t address, uint8_t val)
+    {
+        patchPage((address & (N-1)) >> 8)[address & 0xff] = val;
+    }
 
     /**
      * Return value from memory address.
      */
-    uint8_t getVal(uint_least16_t address) const { return rom[address & (N-1)]; }
+    uint8_t getVal(uint_least16_t address) const
+    {
+        return pages[(address & (N-1)) >> 8][address & 0xff];
+    }
 
     /**
-     * Return pointer to memory address.
+     * Undo all the patches.
      */
-    void* getPtr(uint_least16_t address) const { return (void*)&rom[address & (N-1)]; }
+    void revert() { mapImage(); }
 
 public:
+    romBank() :
+        image(romImages::acquire(nullptr, N)),
+        allocator(nullptr)
+    {
+        mapImage();
+    }
+
+    romBank(const romBank &other) :
+        Bank(other),
+        image(other.image),
+        allocator(other.allocator)
+    {
+        romImages::addRef(image);
+        copyPages(other);
+    }
+
+    ~romBank()
+    {
+        romImages::release(image);
+
+        for (std::vector<uint8_t*>::iterator it = overlay.begin(); it != overlay.end(); ++it)
+            allocated::release(*it);
+    }
+
+    romBank& operator=(const romBank &other)
+    {
+        if (this != &other)
+        {
+            romImages::addRef(other.image);
+            romImages::release(image);
+            image = other.image;
+            copyPages(other);
+        }
+        return *this;
+    }
+
     /**
-     * Copy content from source buffer.
+     * Set the content, a blank image if source is null.
      */
-    void set(const uint8_t* source) { if (source != nullptr) memcpy(rom, source, N); }
+    void set(const uint8_t* source)
+    {
+        const uint8_t* newImage = romImages::acquire(source, N);
+        romImages::release(image);
+        image = newImage;
+        mapImage();
+    }
+
+    /**
+     * Get the memory owned by this bank, in bytes.
+     */
+    size_t overlaySize() const { return overlay.size() * 0x100; }
+
+    /**
+     * Set where the patched pages are placed.
+     */
+    void setAllocator(const SidAllocator* alloc) { allocator = alloc; }
 
     /**
      * Writing to ROM is a no-op.
@@ -77,7 +233,7 @@ public:
     /**
      * Read from ROM.
      */
-    uint8_t peek(uint_least16_t address) override { return rom[address & (N-1)]; }
+    uint8_t peek(uint_least16_t address) override { return getVal(address); }
 };
 
 /**
@@ -87,50 +243,48 @@ public:
  */
 class KernalRomBank final : public romBank<0x2000>
 {
-private:
-    uint8_t resetVectorLo;  // 0xfffc
-    uint8_t resetVectorHi;  // 0xfffd
-
 public:
     void set(const uint8_t* kernal)
     {
-        romBank<0x2000>::set(kernal);
-
-        if (kernal == nullptr)
+        if (kernal != nullptr)
         {
-            // IRQ entry point
-            setVal(0xffa0, PHAn); // Save regs
-            setVal(0xffa1, TXAn);
-            setVal(0xffa2, PHAn);
-            setVal(0xffa3, TYAn);
-            setVal(0xffa4, PHAn);
-            setVal(0xffa5, JMPi); // Jump to IRQ routine
-            setVal(0xffa6, 0x14);
-            setVal(0xffa7, 0x03);
-
-            // Halt
-            setVal(0xea39, 0x02);
-
-            // Hardware vectors
-            setVal(0xfffa, 0x39); // NMI vector
-            setVal(0xfffb, 0xea);
-            setVal(0xfffc, 0x39); // RESET vector
-            setVal(0xfffd, 0xea);
-            setVal(0xfffe, 0xa0); // IRQ/BRK vector
-            setVal(0xffff, 0xff);
+            romBank<0x2000>::set(kernal);
+            return;
         }
 
-        // Backup Reset Vector
-        resetVectorLo = getVal(0xfffc);
-        resetVectorHi = getVal(0xfffd);
+        // Build the replacement stubs once,
+        // they are shared like any other image
+        uint8_t stub[0x2000];
+        memset(stub, 0, sizeof(stub));
+
+        // IRQ entry point
+        stub[0x1fa0] = PHAn; // Save regs
+        stub[0x1fa1] = TXAn;
+        stub[0x1fa2] = PHAn;
+        stub[0x1fa3] = TYAn;
+        stub[0x1fa4] = PHAn;
+        stub[0x1fa5] = JMPi; // Jump to IRQ routine
+        stub[0x1fa6] = 0x14;
+        stub[0x1fa7] = 0x03;
+
+        // Halt
+        stub[0x0a39] = 0x02;
+
+        // Hardware vectors
+        stub[0x1ffa] = 0x39; // NMI vector
+        stub[0x1ffb] = 0xea;
+        stub[0x1ffc] = 0x39; // RESET vector
+        stub[0x1ffd] = 0xea;
+        stub[0x1ffe] = 0xa0; // IRQ/BRK vector
+        stub[0x1fff] = 0xff;
+
+        romBank<0x2000>::set(stub);
     }
 
-    void reset()
-    {
-        // Restore original Reset Vector
-        setVal(0xfffc, resetVectorLo);
-        setVal(0xfffd, resetVectorHi);
-    }
+    /**
+     * Restore the original Reset Vector.
+     */
+    void reset() { revert(); }
 
     /**
      * Change the RESET vector.
@@ -151,28 +305,11 @@ public:
  */
 class BasicRomBank final : public romBank<0x2000>
 {
-private:
-    uint8_t trap[3];
-    uint8_t subTune[11];
-
 public:
-    void set(const uint8_t* basic)
-    {
-        romBank<0x2000>::set(basic);
-
-        // Backup BASIC Warm Start
-        memcpy(trap, getPtr(0xa7ae), sizeof(trap));
-
-        memcpy(subTune, getPtr(0xbf53), sizeof(subTune));
-    }
-
-    void reset()
-    {
-        // Restore original BASIC Warm Start
-        memcpy(getPtr(0xa7ae), trap, sizeof(trap));
-
-        memcpy(getPtr(0xbf53), subTune, sizeof(subTune));
-    }
+    /**
+     * Restore the original BASIC Warm Start and subtune code.
+     */
+    void reset() { revert(); }
 
     /**
      * Set BASIC Warm Start address.
@@ -1468,12 +1468,11 @@ MOS6510::MOS6510(EventScheduler &scheduler) :
 #ifdef DEBUG
     m_fdbg(stdout),
 #endif
+    instrTable(getInstructionTable()),
     m_nosteal("CPU-nosteal", *this, &MOS6510::eventWithoutSteals),
     m_steal("CPU-steal", *this, &MOS6510::eventWithSteals),
     clearInt("Remove IRQ", *this, &MOS6510::removeIRQ)
 {
-    buildInstructionTable();
-
     // Intialise Processor Registers
     Register_Accumulator   = 0;
     Register_X             = 0;
@@ -1487,10 +1486,21 @@ MOS6510::MOS6510(EventScheduler &scheduler) :
     Initialise();
 }
 
+/**
+ * Get the processor instruction table.
+ * The table does not depend on the CPU state so it is built
+ * on first use and shared by all the instances.
+ */
+const MOS6510::ProcessorCycle *MOS6510::getInstructionTable()
+{
+    static const InstructionTable table;
+    return table.cycles;
+}
+
 /**
  * Build up the processor instruction table.
  */
-void MOS6510::buildInstructionTable()
+void MOS6510::buildInstructionTable(ProcessorCycle *instrTable)
 {
     for (unsigned int i = 0; i < 0x100; i++)
     {
@@ -29,6 +29,7 @@
 #include "flags.h"
 #include "EventCallback.h"
 #include "EventScheduler.h"
+#include "sidendian.h"
 
 #ifdef HAVE_CONFIG_H
 #  include "config.h"
@@ -92,6 +93,13 @@ private:
             nosteal(false) {}
     };
 
+    /// Instruction table shared by all the CPU instances
+    struct InstructionTable
+    {
+        ProcessorCycle cycles[0x101 << 3];
+        InstructionTable() { buildInstructionTable(cycles); }
+    };
+
 private:
     /// Event scheduler
     EventScheduler &eventScheduler;
@@ -147,7 +155,7 @@ private:
 #endif
 
     /// Table of CPU opcode implementations
-    struct ProcessorCycle instrTable[0x101 << 3];
+    const ProcessorCycle *instrTable;
 
 private:
     /// Represents an instruction subcycle that writes
@@ -295,7 +303,9 @@ private:
 
     inline bool checkInterrupts() const { return rstFlag || nmiFlag || (irqAssertedOnPin && !flags.getI()); }
 
-    inline void buildInstructionTable();
+    static void buildInstructionTable(ProcessorCycle *instrTable);
+
+    static const ProcessorCycle *getInstructionTable();
 
 protected:
     MOS6510(EventScheduler &scheduler);
@@ -322,9 +332,35 @@ public:
 
     static const char *credits();
 
+    /**
+     * Get the size of the instruction table shared by all the instances.
+     */
+    static size_t getInstructionTableSize() { return sizeof(InstructionTable); }
+
     void debug(bool enable, FILE *out);
     void setRDY(bool newRDY);
 
+    /**
+     * Get the program counter.
+     */
+    uint_least16_t getPC() const { return Register_ProgramCounter; }
+
+    /**
+     * Get a snapshot of the registers.
+     *
+     * @param regs filled with PC low, PC high, A, X, Y, SP and the status flags
+     */
+    void getRegisters(uint8_t regs[7]) const
+    {
+        regs[0] = endian_16lo8(Register_ProgramCounter);
+        regs[1] = endian_16hi8(Register_ProgramCounter);
+        regs[2] = Register_Accumulator;
+        regs[3] = Register_X;
+        regs[4] = Register_Y;
+        regs[5] = Register_StackPointer;
+        regs[6] = flags.get();
+    }
+
     // Non-standard functions
     void triggerRST();
     void triggerNMI();
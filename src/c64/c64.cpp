@@ -79,15 +79,17 @@ double c64::getCpuFreq(model_t model)
     return crystalFreq / modelData[model].divider;
 }
 
-c64::c64() :
+c64::c64(const SidAllocator *allocator) :
     c64env(eventScheduler),
     cpuFrequency(getCpuFreq(PAL_B)),
+    irqRequests(0),
+    nmiRequests(0),
     cpu(*this),
     cia1(*this),
     cia2(*this),
     vic(*this),
     disconnectedBusBank(mmu),
-    mmu(eventScheduler, &ioBank)
+    mmu(eventScheduler, &ioBank, allocator)
 {
     resetIoBank();
 }
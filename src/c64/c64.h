@@ -98,6 +98,10 @@ private:
     /// Number of sources asserting IRQ
     int irqCount;
 
+    /// Number of IRQ and NMI requests, wrapping around
+    uint_least32_t irqRequests;
+    uint_least32_t nmiRequests;
+
     /// BA state
     bool oldBAState;
 
@@ -168,7 +172,7 @@ private:
      *
      * Calls permitted any time, but normally originated by chips at PHI1.
      */
-    inline void interruptNMI() override { cpu.triggerNMI(); }
+    inline void interruptNMI() override { nmiRequests++; cpu.triggerNMI(); }
 
     /**
      * Reset signal.
@@ -192,7 +196,10 @@ private:
     void resetIoBank();
 
 public:
-    c64();
+    /**
+     * @param allocator where to place the memory pages, nullptr for the heap
+     */
+    c64(const SidAllocator *allocator = nullptr);
     ~c64();
 
     /**
@@ -216,9 +223,39 @@ public:
 
     void debug(bool enable, FILE *out) { cpu.debug(enable, out); }
 
+    /**
+     * Get the number of IRQ requests, wrapping around.
+     */
+    uint_least32_t getIrqRequests() const { return irqRequests; }
+
+    /**
+     * Get the number of NMI requests, wrapping around.
+     */
+    uint_least32_t getNmiRequests() const { return nmiRequests; }
+
+    /**
+     * Get the CPU program counter.
+     */
+    uint_least16_t getCpuPC() const { return cpu.getPC(); }
+
+    /**
+     * Get a snapshot of the CPU registers.
+     */
+    void getCpuStatus(uint8_t regs[7]) const { cpu.getRegisters(regs); }
+
+    /**
+     * Get the memory allocated for the extra SID banks, in bytes.
+     */
+    size_t getExtraSidBanksSize() const { return extraSidBanks.size() * sizeof(ExtraSidBank); }
+
     void reset();
     void resetCpu() { cpu.reset(); }
 
+    /**
+     * Restart the pseudo random sequences of the machine.
+     */
+    void setSeed(unsigned int seed) { mmu.setSeed(seed); }
+
     /**
      * Set the c64 model.
      */
@@ -270,6 +307,15 @@ public:
 
     sidmemory& getMemInterface() { return mmu; }
 
+    /**
+     * Copy the ROM images from another machine.
+     */
+    void copyRoms(const c64 &other) { mmu.copyRoms(other.mmu); }
+
+    size_t getRomOverlaySize() const { return mmu.getRomOverlaySize(); }
+
+    size_t getRamPagesSize() const { return mmu.getRamPagesSize(); }
+
     uint_least16_t getCia1TimerA() const { return cia1.getTimerA(); }
 };
 
@@ -278,7 +324,10 @@ void c64::interruptIRQ(bool state)
     if (state)
     {
         if (irqCount == 0)
+        {
+            irqRequests++;
             cpu.triggerIRQ();
+        }
 
         irqCount ++;
     }
@@ -39,26 +39,44 @@ class c64sid : public Bank
 private:
     uint8_t lastpoke[0x20];
 
+    /// Number of register writes from the bus
+    uint_least32_t writes;
+
 protected:
+    c64sid() : writes(0) {}
     virtual ~c64sid() {}
 
+    /**
+     * Record a register write bypassing the bus.
+     */
+    void setStatus(uint_least8_t addr, uint8_t data) { lastpoke[addr & 0x1f] = data; }
+
     virtual uint8_t read(uint_least8_t addr) = 0;
     virtual void write(uint_least8_t addr, uint8_t data) = 0;
 
 public:
     virtual void reset(uint8_t volume) = 0;
 
-    void reset() { memset(lastpoke, 0, 0x20); reset(0); }
+    void reset() { clearStatus(); reset(0); }
+
+    void clearStatus() { memset(lastpoke, 0, 0x20); }
 
     // Bank functions
     void poke(uint_least16_t address, uint8_t value) override
     {
         lastpoke[address & 0x1f] = value;
+        writes++;
         write(address & 0x1f, value);
     }
     uint8_t peek(uint_least16_t address) override { return read(address & 0x1f); }
 
     void getStatus(uint8_t regs[0x20]) const { memcpy(regs, lastpoke, 0x20); }
+
+    /**
+     * Get the number of register writes from the bus,
+     * wrapping around.
+     */
+    uint_least32_t getWrites() const { return writes; }
 };
 
 }
@@ -30,7 +30,7 @@ namespace libsidplayfp
 
 class Bank;
 
-MMU::MMU(EventScheduler &scheduler, IOBank* ioBank) :
+MMU::MMU(EventScheduler &scheduler, IOBank* ioBank, const SidAllocator* allocator) :
     eventScheduler(scheduler),
     loram(false),
     hiram(false),
@@ -39,6 +39,11 @@ MMU::MMU(EventScheduler &scheduler, IOBank* ioBank) :
     zeroRAMBank(*this, ramBank),
     seed(3686734)
 {
+    kernalRomBank.setAllocator(allocator);
+    basicRomBank.setAllocator(allocator);
+    characterRomBank.setAllocator(allocator);
+    ramBank.setAllocator(allocator);
+
     cpuReadMap[0] = &zeroRAMBank;
     cpuWriteMap[0] = &zeroRAMBank;
 
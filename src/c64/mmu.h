@@ -90,29 +90,60 @@ private:
     void updateMappingPHI2();
 
 public:
-    MMU(EventScheduler &eventScheduler, IOBank* ioBank);
+    /**
+     * @param allocator where to place the RAM and ROM pages, nullptr for the heap
+     */
+    MMU(EventScheduler &eventScheduler, IOBank* ioBank, const SidAllocator* allocator);
 
     void reset();
 
+    /**
+     * Restart the pseudo random sequence of the open bus reads.
+     */
+    void setSeed(unsigned int value) { seed = value; }
+
     // ROM banks methods
     void setKernal(const uint8_t* rom) override { kernalRomBank.set(rom); }
     void setBasic(const uint8_t* rom) override { basicRomBank.set(rom); }
     void setChargen(const uint8_t* rom) override { characterRomBank.set(rom); }
 
+    /**
+     * Copy the ROM banks from another MMU.
+     */
+    void copyRoms(const MMU &other)
+    {
+        kernalRomBank = other.kernalRomBank;
+        basicRomBank = other.basicRomBank;
+        characterRomBank = other.characterRomBank;
+    }
+
+    /**
+     * Get the memory used by the patched ROM pages.
+     */
+    size_t getRomOverlaySize() const
+    {
+        return kernalRomBank.overlaySize() + basicRomBank.overlaySize() + characterRomBank.overlaySize();
+    }
+
+    /**
+     * Get the memory used by the private RAM pages.
+     */
+    size_t getRamPagesSize() const { return ramBank.pagesSize(); }
+
     // RAM access methods
     uint8_t readMemByte(uint_least16_t addr) override { return ramBank.peek(addr); }
-    uint_least16_t readMemWord(uint_least16_t addr) override { return endian_little16(ramBank.ram+addr); }
+    uint_least16_t readMemWord(uint_least16_t addr) override { return ramBank.readWord(addr); }
 
     void writeMemByte(uint_least16_t addr, uint8_t value) override { ramBank.poke(addr, value); }
-    void writeMemWord(uint_least16_t addr, uint_least16_t value) override { endian_little16(ramBank.ram+addr, value); }
+    void writeMemWord(uint_least16_t addr, uint_least16_t value) override { ramBank.writeWord(addr, value); }
 
     void fillRam(uint_least16_t start, uint8_t value, unsigned int size) override
     {
-        memset(ramBank.ram+start, value, size);
+        ramBank.fill(start, value, size);
     }
     void fillRam(uint_least16_t start, const uint8_t* source, unsigned int size) override
     {
-        memcpy(ramBank.ram+start, source, size);
+        ramBank.fill(start, source, size);
     }
 
     // SID specific hacks
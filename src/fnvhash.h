@@ -0,0 +1,80 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef FNVHASH_H
+#define FNVHASH_H
+
+#include <stdint.h>
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+/**
+ * 64 bit FNV-1a hash.
+ * Values are fed in little endian order so the result
+ * does not depend on the platform.
+ */
+class fnvHash
+{
+private:
+    uint_least64_t m_hash;
+
+public:
+    fnvHash() : m_hash(0xcbf29ce484222325ULL) {}
+
+    void add(uint_least32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            m_hash ^= (value >> (i * 8)) & 0xff;
+            m_hash *= 0x100000001b3ULL;
+        }
+    }
+
+    void add64(uint_least64_t value)
+    {
+        add(static_cast<uint_least32_t>(value & 0xffffffff));
+        add(static_cast<uint_least32_t>(value >> 32));
+    }
+
+    void addDouble(double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        add64(bits);
+    }
+
+    void add(const char *str)
+    {
+        while (*str)
+        {
+            m_hash ^= static_cast<unsigned char>(*str++);
+            m_hash *= 0x100000001b3ULL;
+        }
+        add(0u);
+    }
+
+    uint_least64_t get() const { return m_hash; }
+};
+
+}
+
+#endif // FNVHASH_H
@@ -148,6 +148,13 @@ void Mixer::begin(short *buffer, uint_least32_t count)
 
 void Mixer::updateParams()
 {
+    if (m_shared)
+    {
+        m_mix[0] = &Mixer::shared_ch1;
+        if (m_stereo) m_mix[1] = &Mixer::shared_ch2;
+        return;
+    }
+
     switch (m_buffers.size())
     {
     case 1:
@@ -165,10 +172,21 @@ void Mixer::updateParams()
      }
 }
 
+size_t Mixer::memoryUsage() const
+{
+    return m_chips.capacity() * sizeof(sidemu*)
+        + m_buffers.capacity() * sizeof(short*)
+        + m_iSamples.capacity() * sizeof(int_least32_t)
+        + m_volume.capacity() * sizeof(int_least32_t)
+        + m_mix.capacity() * sizeof(mixer_func_t)
+        + m_scale.capacity() * sizeof(scale_func_t);
+}
+
 void Mixer::clearSids()
 {
     m_chips.clear();
     m_buffers.clear();
+    m_shared = false;
 }
 
 void Mixer::addSid(sidemu *chip)
@@ -197,6 +215,45 @@ void Mixer::setStereo(bool stereo)
     }
 }
 
+void Mixer::shareOutput(bool enable)
+{
+    if (m_shared)
+    {
+        m_chips.front()->unshareOutput();
+        m_shared = false;
+    }
+
+    const unsigned int chips = m_chips.size();
+    if (enable && (chips > 1))
+    {
+        // Same matrix as the sample rate mixing functions
+        const unsigned int channels = m_stereo ? 2 : 1;
+        std::vector<int_least32_t> matrix(channels * chips, 0);
+        if (!m_stereo)
+        {
+            for (unsigned int i = 0; i < chips; i++)
+                matrix[i] = SCALE_FACTOR / chips;
+        }
+        else if (chips == 2)
+        {
+            matrix[0] = SCALE_FACTOR;
+            matrix[3] = SCALE_FACTOR;
+        }
+        else
+        {
+            matrix[0] = C1;
+            matrix[1] = C2;
+            matrix[4] = C2;
+            matrix[5] = C1;
+        }
+
+        const std::vector<sidemu*> chipList(m_chips.begin(), m_chips.end());
+        m_shared = m_chips.front()->shareOutput(chipList, matrix, channels);
+    }
+
+    updateParams();
+}
+
 void Mixer::setSamplerate(uint_least32_t rate)
 {
     m_sampleRate = rate;
@@ -204,7 +261,7 @@ void Mixer::setSamplerate(uint_least32_t rate)
 
 bool Mixer::setFastForward(int ff)
 {
-    if (ff < 1 || ff > 32)
+    if (ff < 1 || ff > MAX_FAST_FORWARD)
         return false;
 
     m_fastForwardFactor = ff;
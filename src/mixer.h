@@ -24,9 +24,11 @@
 #ifndef MIXER_H
 #define MIXER_H
 
+#include "allocator.h"
 #include "sidcxx11.h"
 
 #include <stdint.h>
+#include <cstddef>
 
 #include <vector>
 
@@ -88,15 +90,18 @@ public:
     /// Maximum allowed volume, must be a power of 2.
     static const int_least32_t VOLUME_MAX = 1024;
 
+    /// Maximum fast forward factor
+    static const int MAX_FAST_FORWARD = 32;
+
 private:
-    std::vector<sidemu*> m_chips;
-    std::vector<short*> m_buffers;
+    std::vector<sidemu*, stlAllocator<sidemu*> > m_chips;
+    std::vector<short*, stlAllocator<short*> > m_buffers;
 
-    std::vector<int_least32_t> m_iSamples;
-    std::vector<int_least32_t> m_volume;
+    std::vector<int_least32_t, stlAllocator<int_least32_t> > m_iSamples;
+    std::vector<int_least32_t, stlAllocator<int_least32_t> > m_volume;
 
-    std::vector<mixer_func_t> m_mix;
-    std::vector<scale_func_t> m_scale;
+    std::vector<mixer_func_t, stlAllocator<mixer_func_t> > m_mix;
+    std::vector<scale_func_t, stlAllocator<scale_func_t> > m_scale;
 
     int m_oldRandomValue;
     int m_fastForwardFactor;
@@ -110,6 +115,9 @@ private:
 
     bool m_stereo;
 
+    /// The chips are mixed by a shared output stage
+    bool m_shared;
+
     randomLCG<VOLUME_MAX> m_rand;
 
 private:
@@ -173,16 +181,29 @@ private:
     int_least32_t stereo_ch1_ThreeChips() const { return (C1*m_iSamples[0] + C2*m_iSamples[1]) / SCALE_FACTOR; }
     int_least32_t stereo_ch2_ThreeChips() const { return (C2*m_iSamples[1] + C1*m_iSamples[2]) / SCALE_FACTOR; }
 
+    // Channels already mixed by the chips
+    int_least32_t shared_ch1() const { return m_iSamples[0]; }
+    int_least32_t shared_ch2() const { return m_iSamples[1]; }
+
 public:
     /**
      * Create a new mixer.
+     *
+     * @param allocator where to place the mixer state, nullptr for the heap
      */
-    Mixer() :
+    Mixer(const SidAllocator *allocator = nullptr) :
+        m_chips(stlAllocator<sidemu*>(allocator)),
+        m_buffers(stlAllocator<short*>(allocator)),
+        m_iSamples(stlAllocator<int_least32_t>(allocator)),
+        m_volume(stlAllocator<int_least32_t>(allocator)),
+        m_mix(stlAllocator<mixer_func_t>(allocator)),
+        m_scale(stlAllocator<scale_func_t>(allocator)),
         m_oldRandomValue(0),
         m_fastForwardFactor(1),
         m_sampleCount(0),
         m_sampleRate(0),
         m_stereo(false),
+        m_shared(false),
         m_rand(257254)
     {
         m_mix.push_back(&Mixer::mono<1>);
@@ -241,6 +262,27 @@ public:
      */
     bool setFastForward(int ff);
 
+    /**
+     * Restart the dithering noise sequence.
+     *
+     * @param seed the new seed
+     */
+    void setSeed(uint32_t seed)
+    {
+        m_rand = randomLCG<VOLUME_MAX>(seed);
+        m_oldRandomValue = 0;
+    }
+
+    /**
+     * Get the fast forward ratio.
+     */
+    int getFastForward() const { return m_fastForwardFactor; }
+
+    /**
+     * Get the memory allocated by the mixer, in bytes.
+     */
+    size_t memoryUsage() const;
+
     /**
      * Set mixing volumes, from 0 to #VOLUME_MAX.
      *
@@ -256,6 +298,16 @@ public:
      */
     void setStereo(bool stereo);
 
+    /**
+     * Let the chips mix themselves at clock rate and resample
+     * once per output channel, if the emulation supports it.
+     * Must be called after the chips are added
+     * and the mixing mode is set.
+     *
+     * @param enable true to share the output stage
+     */
+    void shareOutput(bool enable);
+
     /**
      * Set sample rate.
      *
@@ -24,6 +24,7 @@
 #include "player.h"
 
 #include "sidplayfp/SidTune.h"
+#include "sidplayfp/SidProbe.h"
 #include "sidplayfp/sidbuilder.h"
 
 #include "sidemu.h"
@@ -32,6 +33,16 @@
 
 #include "sidcxx11.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef HAVE_CXX11
+#  include <chrono>
+#else
+#  include <ctime>
+#endif
+
 namespace libsidplayfp
 {
 
@@ -51,6 +62,17 @@ const char ERR_UNSUPPORTED_FREQ[]     = "SIDPLAYER ERROR: Unsupported sampling f
 const char ERR_UNSUPPORTED_SID_ADDR[] = "SIDPLAYER ERROR: Unsupported SID address.";
 const char ERR_UNSUPPORTED_SIZE[]     = "SIDPLAYER ERROR: Size of music data exceeds C64 memory.";
 const char ERR_INVALID_PERCENTAGE[]   = "SIDPLAYER ERROR: Percentage value out of range.";
+const char ERR_NO_TUNE[]              = "SIDPLAYER ERROR: No tune loaded.";
+const char ERR_REPLAY_SIDS[]          = "SIDPLAYER ERROR: Replay needs a single SID.";
+const char ERR_REPLAY_UNSUPPORTED[]   = "SIDPLAYER ERROR: The SID emulation does not support replay.";
+
+/// Cycles between two samples of the CPU program counter,
+/// coprime with the raster line lengths
+const unsigned int PROBE_SAMPLE_CYCLES = 61;
+
+/// Longest time between two events,
+/// the VIC-II runs at least once per raster line
+const event_clock_t MAX_EVENT_GAP = 65;
 
 /**
  * Configuration error exception.
@@ -65,12 +87,60 @@ public:
     const char* message() const { return m_msg; }
 };
 
-Player::Player() :
+/**
+ * Sample the CPU program counter to estimate
+ * the time spent in the player driver.
+ */
+class driverSampler final : public Event
+{
+private:
+    EventScheduler &m_scheduler;
+
+    const c64 &m_c64;
+
+    const unsigned int m_start;
+    const unsigned int m_end;
+
+public:
+    unsigned int samples;
+    unsigned int hits;
+
+public:
+    driverSampler(EventScheduler &scheduler, const c64 &c64, uint_least16_t addr, uint_least16_t length) :
+        Event("Driver sampler"),
+        m_scheduler(scheduler),
+        m_c64(c64),
+        m_start(addr),
+        m_end(addr + length),
+        samples(0),
+        hits(0) {}
+
+    /// Never left scheduled, also when play() throws
+    ~driverSampler() { m_scheduler.cancel(*this); }
+
+    void event() override
+    {
+        samples++;
+
+        const unsigned int pc = m_c64.getCpuPC();
+        if ((pc >= m_start) && (pc < m_end))
+            hits++;
+
+        m_scheduler.schedule(*this, PROBE_SAMPLE_CYCLES);
+    }
+};
+
+Player::Player(const SidAllocator *allocator) :
+    m_allocator(allocator),
+    m_c64(allocator),
+    m_mixer(allocator),
     // Set default settings for system
     m_tune(nullptr),
     m_errorString(ERR_NA),
     m_isPlaying(STOPPED),
-    m_rand((unsigned int)::time(0))
+    m_rand((unsigned int)::time(0)),
+    m_eventCount(0),
+    m_batchCycles(0)
 {
     // We need at least some minimal interrupt handling
     m_c64.getMemInterface().setKernal(nullptr);
@@ -83,8 +153,64 @@ Player::Player() :
     m_info.m_credits.push_back(m_c64.vicCredits());
 }
 
+Player::Player(const Player &prototype) :
+    m_allocator(prototype.m_allocator),
+    m_c64(prototype.m_allocator),
+    m_mixer(prototype.m_allocator),
+    m_tune(nullptr),
+    m_errorString(ERR_NA),
+    m_isPlaying(STOPPED),
+    m_rand((unsigned int)::time(0)),
+    m_eventCount(0),
+    m_batchCycles(0)
+{
+    // ROMs are already identified, copy them with their descriptions
+    m_c64.copyRoms(prototype.m_c64);
+
+    m_info.m_credits = prototype.m_info.m_credits;
+    m_info.m_kernalDesc = prototype.m_info.m_kernalDesc;
+    m_info.m_basicDesc = prototype.m_info.m_basicDesc;
+    m_info.m_chargenDesc = prototype.m_info.m_chargenDesc;
+    for (int i = 0; i < 3; i++)
+        m_info.m_romDigests[i] = prototype.m_info.m_romDigests[i];
+
+    m_mixer.setFastForward(prototype.m_mixer.getFastForward());
+}
+
+Player *Player::clone() const
+{
+    Player *player = new (m_allocator) Player(*this);
+
+    // Create the SIDs and place the tune
+    player->m_tune = m_tune;
+    if (!player->config(m_cfg, true))
+    {
+        delete player;
+        return nullptr;
+    }
+
+    return player;
+}
+
+/**
+ * 64 bit FNV-1a hash of the ROM content, 0 if not set.
+ */
+inline uint_least64_t romDigest(const uint8_t* rom, unsigned int size)
+{
+    if (rom == nullptr)
+        return 0;
+
+    uint_least64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        hash ^= rom[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 template<class T>
-inline void checkRom(const uint8_t* rom, std::string &desc)
+inline void checkRom(const uint8_t* rom, unsigned int size, std::string &desc, uint_least64_t &digest)
 {
     if (rom != nullptr)
     {
@@ -93,23 +219,25 @@ inline void checkRom(const uint8_t* rom, std::string &desc)
     }
     else
         desc.clear();
+
+    digest = romDigest(rom, size);
 }
 
 void Player::setKernal(const uint8_t* rom)
 {
-    checkRom<kernalCheck>(rom, m_info.m_kernalDesc);
+    checkRom<kernalCheck>(rom, 0x2000, m_info.m_kernalDesc, m_info.m_romDigests[0]);
     m_c64.getMemInterface().setKernal(rom);
 }
 
 void Player::setBasic(const uint8_t* rom)
 {
-    checkRom<basicCheck>(rom, m_info.m_basicDesc);
+    checkRom<basicCheck>(rom, 0x2000, m_info.m_basicDesc, m_info.m_romDigests[1]);
     m_c64.getMemInterface().setBasic(rom);
 }
 
 void Player::setChargen(const uint8_t* rom)
 {
-    checkRom<chargenCheck>(rom, m_info.m_chargenDesc);
+    checkRom<chargenCheck>(rom, 0x1000, m_info.m_chargenDesc, m_info.m_romDigests[2]);
     m_c64.getMemInterface().setChargen(rom);
 }
 
@@ -124,10 +252,24 @@ bool Player::fastForward(unsigned int percent)
     return true;
 }
 
-void Player::initialise()
+void Player::initialise(uint_least32_t seed)
 {
     m_isPlaying = STOPPED;
 
+    if (seed != 0)
+    {
+        // Clear the chip state that survives a reset
+        // so that the output does not depend on the previous song
+        for (unsigned int i = 0; ; i++)
+        {
+            sidemu *s = m_mixer.getSid(i);
+            if (s == nullptr)
+                break;
+
+            s->powerOn();
+        }
+    }
+
     m_c64.reset();
 
     const SidTuneInfo* tuneInfo = m_tune->getInfo();
@@ -138,6 +280,18 @@ void Player::initialise()
         throw configError(ERR_UNSUPPORTED_SIZE);
     }
 
+    if (seed != 0)
+    {
+        // Restart all the random sequences from the seed
+        // so that each song start is reproducible
+        m_rand = sidrandom(seed);
+        m_c64.setSeed(m_rand.next());
+        m_mixer.setSeed(m_rand.next());
+    }
+
+    // Drop the samples left from the previous song
+    m_mixer.resetBufs();
+
     uint_least16_t powerOnDelay = m_cfg.powerOnDelay;
     // Delays above MAX result in random delays
     if (powerOnDelay > SidConfig::MAX_POWER_ON_DELAY)
@@ -187,7 +341,13 @@ void Player::mute(unsigned int sidNum, unsigned int voice, bool enable)
 {
     sidemu *s = m_mixer.getSid(sidNum);
     if (s != nullptr)
-        s->voice(voice, enable);
+        s->mute(voice, enable);
+}
+
+bool Player::isMuted(unsigned int sidNum, unsigned int voice) const
+{
+    const sidemu *s = m_mixer.getSid(sidNum);
+    return (s != nullptr) && s->isMuted(voice);
 }
 
 /**
@@ -195,8 +355,32 @@ void Player::mute(unsigned int sidNum, unsigned int voice, bool enable)
  */
 void Player::run(unsigned int events)
 {
-    for (unsigned int i = 0; m_isPlaying && i < events; i++)
+    unsigned int i = 0;
+    for (; m_isPlaying && i < events; i++)
         m_c64.clock();
+
+    m_eventCount += i;
+}
+
+/**
+ * @throws MOS6510::haltInstruction
+ */
+void Player::runBatch()
+{
+    if (m_batchCycles == 0)
+    {
+        run(sidemu::OUTPUTBUFFERSIZE);
+        return;
+    }
+
+    EventScheduler &scheduler = *m_c64.getEventScheduler();
+    const event_clock_t end = scheduler.getTime(EVENT_CLOCK_PHI1) + m_batchCycles;
+
+    unsigned int i = 0;
+    for (; m_isPlaying && scheduler.getTime(EVENT_CLOCK_PHI1) < end; i++)
+        m_c64.clock();
+
+    m_eventCount += i;
 }
 
 uint_least32_t Player::play(short *buffer, uint_least32_t count)
@@ -222,10 +406,15 @@ uint_least32_t Player::play(short *buffer, uint_least32_t count)
                     // reset count in case of exceptions
                     count = 0;
 
+                    // Mix the samples left from the previous call first,
+                    // so that fewer than the fast forward factor are
+                    // still in the chip buffers when clocking them
+                    m_mixer.doMix();
+
                     // Clock chips and mix into output buffer
                     while (m_isPlaying && m_mixer.notFinished())
                     {
-                        run(sidemu::OUTPUTBUFFERSIZE);
+                        runBatch();
 
                         m_mixer.clockChips();
                         m_mixer.doMix();
@@ -235,10 +424,12 @@ uint_least32_t Player::play(short *buffer, uint_least32_t count)
                 else
                 {
                     // Clock chips and discard buffers
-                    int size = m_c64.getMainCpuSpeed() / m_cfg.frequency;
+                    m_mixer.resetBufs();
+
+                    int size = std::max(2, static_cast<int>(m_c64.getMainCpuSpeed() / m_info.m_sampleRate));
                     while (m_isPlaying && --size)
                     {
-                        run(sidemu::OUTPUTBUFFERSIZE);
+                        runBatch();
 
                         m_mixer.clockChips();
                         m_mixer.resetBufs();
@@ -248,7 +439,7 @@ uint_least32_t Player::play(short *buffer, uint_least32_t count)
             else
             {
                 // Clock the machine
-                int size = m_c64.getMainCpuSpeed() / m_cfg.frequency;
+                int size = std::max(2, static_cast<int>(m_c64.getMainCpuSpeed() / m_info.m_sampleRate));
                 while (m_isPlaying && --size)
                 {
                     run(sidemu::OUTPUTBUFFERSIZE);
@@ -271,7 +462,7 @@ uint_least32_t Player::play(short *buffer, uint_least32_t count)
     {
         try
         {
-            initialise();
+            initialise(m_cfg.seed);
         }
         catch (configError const &) {}
         m_isPlaying = STOPPED;
@@ -299,6 +490,33 @@ c64::cia_model_t getCiaModel(SidConfig::cia_model_t model)
     }
 }
 
+/**
+ * Get the length of a play batch at clock rate, in cycles.
+ * The batch can overrun by one event, and yields a sample every
+ * factor cycles plus one. With the fewer than fast forward factor
+ * samples left by the mix, they must fit the chip buffers.
+ *
+ * @param factor the CPU clock over the output rate
+ */
+event_clock_t clockRateBatch(double factor)
+{
+    const event_clock_t maxSamples = sidemu::OUTPUTBUFFERSIZE - Mixer::MAX_FAST_FORWARD - 1;
+    return maxSamples * static_cast<event_clock_t>(factor + 0.5) - MAX_EVENT_GAP;
+}
+
+/**
+ * Get the actual output rate.
+ * With clock rate output the CPU clock is divided by an integer factor.
+ */
+double outputFrequency(double cpuFreq, const SidConfig &cfg)
+{
+    if (cfg.samplingMethod != SidConfig::CLOCK_RATE)
+        return cfg.frequency;
+
+    const double factor = std::floor(cpuFreq / cfg.frequency + 0.5);
+    return factor > 1. ? cpuFreq / factor : cpuFreq;
+}
+
 bool Player::config(const SidConfig &cfg, bool force)
 {
     // Check if configuration have been changed or forced
@@ -347,10 +565,10 @@ bool Player::config(const SidConfig &cfg, bool force)
             const c64::cia_model_t ciaModel = getCiaModel(cfg.ciaModel);
             m_c64.setCiaModel(ciaModel);
 
-            sidParams(m_c64.getMainCpuSpeed(), cfg.frequency, cfg.samplingMethod, cfg.fastSampling);
+            sidParams(m_c64.getMainCpuSpeed(), outputFrequency(m_c64.getMainCpuSpeed(), cfg), cfg.samplingMethod, cfg.fastSampling);
 
             // Configure, setup and install C64 environment/events
-            initialise();
+            initialise(cfg.seed);
         }
         catch (configError const &e)
         {
@@ -367,9 +585,18 @@ bool Player::config(const SidConfig &cfg, bool force)
     const bool isStereo = cfg.playback == SidConfig::STEREO;
     m_info.m_channels = isStereo ? 2 : 1;
 
+    const double sampleRate = outputFrequency(m_c64.getMainCpuSpeed(), cfg);
+    m_info.m_sampleRate = sampleRate;
+
+    // At clock rate an event may yield more than one sample,
+    // bound the batches in cycles instead
+    m_batchCycles = (cfg.samplingMethod == SidConfig::CLOCK_RATE) ?
+        clockRateBatch(m_c64.getMainCpuSpeed() / sampleRate) : 0;
+
     m_mixer.setStereo(isStereo);
-    m_mixer.setSamplerate(cfg.frequency);
+    m_mixer.setSamplerate(static_cast<uint_least32_t>(sampleRate + 0.5));
     m_mixer.setVolume(cfg.leftVolume, cfg.rightVolume);
+    m_mixer.shareOutput(cfg.sharedResampler);
 
     // Update Configuration
     m_cfg = cfg;
@@ -567,7 +794,7 @@ void Player::sidCreate(sidbuilder *builder, SidConfig::sid_model_t defaultModel,
     }
 }
 
-void Player::sidParams(double cpuFreq, int frequency,
+void Player::sidParams(double cpuFreq, double frequency,
                         SidConfig::sampling_method_t sampling, bool fastSampling)
 {
     for (unsigned int i = 0; ; i++)
@@ -591,4 +818,179 @@ bool Player::getSidStatus(unsigned int sidNum, uint8_t regs[32])
     return true;
 }
 
+void Player::memoryUsage(size_t &privateBytes, size_t &sharedBytes) const
+{
+    privateBytes = sizeof(Player) + m_c64.getExtraSidBanksSize()
+        + m_c64.getRomOverlaySize() + m_c64.getRamPagesSize() + m_mixer.memoryUsage();
+    sharedBytes = MOS6510::getInstructionTableSize()
+        + romImages::memoryUsage() + SystemRAMBank::powerOnImageSize();
+
+    for (unsigned int i = 0; ; i++)
+    {
+        const sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        privateBytes += s->memoryUsage();
+    }
+
+    // All the chips come from the same builder
+    // and share the same tables
+    const sidemu *s = m_mixer.getSid(0);
+    if (s != nullptr)
+        sharedBytes += s->sharedMemoryUsage();
+}
+
+bool Player::probe(uint_least32_t ms, SidProbe &result)
+{
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return false;
+    }
+
+    EventScheduler &scheduler = *m_c64.getEventScheduler();
+
+    std::vector<uint_least32_t> writes;
+    for (unsigned int i = 0; ; i++)
+    {
+        const sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        writes.push_back(s->getWrites());
+    }
+
+    const uint_least32_t irqs = m_c64.getIrqRequests();
+    const uint_least32_t nmis = m_c64.getNmiRequests();
+    const uint_least32_t events = m_eventCount;
+    const event_clock_t cycles = scheduler.getTime(EVENT_CLOCK_PHI1);
+    const uint_least32_t startMs = timeMs();
+
+    driverSampler sampler(scheduler, m_c64, m_info.driverAddr(), m_info.driverLength());
+    scheduler.schedule(sampler, PROBE_SAMPLE_CYCLES);
+
+#ifdef HAVE_CXX11
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#else
+    const std::clock_t start = std::clock();
+#endif
+
+    // Clock the chips without producing samples
+    bool failed = false;
+    while (timeMs() - startMs < ms)
+    {
+        play(nullptr, 0);
+        if (m_isPlaying == STOPPED)
+        {
+            failed = true;
+            break;
+        }
+    }
+
+#ifdef HAVE_CXX11
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#else
+    const double elapsed = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+#endif
+
+    scheduler.cancel(sampler);
+
+    if (failed)
+        return false;
+
+    result.timeMs = timeMs() - startMs;
+    result.cpuCycles = scheduler.getTime(EVENT_CLOCK_PHI1) - cycles;
+    result.idleCycles = sampler.samples != 0 ? result.cpuCycles * sampler.hits / sampler.samples : 0;
+
+    const double seconds = result.cpuCycles / m_c64.getMainCpuSpeed();
+    const double rate = seconds > 0. ? 1. / seconds : 0.;
+
+    result.irqRate = (m_c64.getIrqRequests() - irqs) * rate;
+    result.nmiRate = (m_c64.getNmiRequests() - nmis) * rate;
+    // The sampler events are not part of the tune cost
+    result.eventRate = (m_eventCount - events - sampler.samples) * rate;
+
+    uint_least32_t sidWrites = 0;
+    result.sidChips = writes.size();
+    result.sidChipsUsed = 0;
+    for (unsigned int i = 0; i < writes.size(); i++)
+    {
+        const uint_least32_t n = m_mixer.getSid(i)->getWrites() - writes[i];
+        sidWrites += n;
+        if (n != 0)
+            result.sidChipsUsed++;
+    }
+    result.sidWriteRate = sidWrites * rate;
+
+    result.realtimeFactor = elapsed > 0. ? seconds / elapsed : 0.;
+
+    // Restart the tune
+    try
+    {
+        initialise(m_cfg.seed);
+    }
+    catch (configError const &e)
+    {
+        m_errorString = e.message();
+        return false;
+    }
+
+    return true;
+}
+
+uint_least32_t Player::replay(const SidWrite *writes, unsigned int n,
+                              short *buffer, uint_least32_t count, unsigned int &applied)
+{
+    applied = 0;
+
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return 0;
+    }
+
+    // The mixer expects all the chips at the same position
+    sidemu *s = m_mixer.getSid(0);
+    if ((s == nullptr) || (m_mixer.getSid(1) != nullptr))
+    {
+        m_errorString = ERR_REPLAY_SIDS;
+        return 0;
+    }
+
+    // The chip runs ahead of the machine, restart at the next play
+    m_isPlaying = STOPPING;
+
+    try
+    {
+        m_mixer.begin(buffer, count);
+    }
+    catch (Mixer::badBufferSize const &)
+    {
+        m_errorString = "Bad buffer size";
+        return 0;
+    }
+
+    // Mix whenever the chip buffer fills up
+    while (m_mixer.notFinished())
+    {
+        unsigned int done;
+        if (!s->writeBatch(writes + applied, n - applied, done))
+        {
+            m_errorString = ERR_REPLAY_UNSUPPORTED;
+            break;
+        }
+        applied += done;
+
+        const uint_least32_t generated = m_mixer.samplesGenerated();
+        m_mixer.doMix();
+
+        // After the last write mix out what has been clocked
+        if ((applied == n) && (m_mixer.samplesGenerated() == generated))
+            break;
+    }
+
+    return m_mixer.samplesGenerated();
+}
+
 }
@@ -32,6 +32,7 @@
 #include "sidplayfp/SidTuneInfo.h"
 
 #include "SidInfoImpl.h"
+#include "allocator.h"
 #include "sidrandom.h"
 #include "mixer.h"
 #include "c64/c64.h"
@@ -47,13 +48,15 @@
 
 class SidTune;
 class SidInfo;
+class SidProbe;
 class sidbuilder;
+struct SidWrite;
 
 
 namespace libsidplayfp
 {
 
-class Player
+class Player : public allocated
 {
 private:
     typedef enum
@@ -64,6 +67,9 @@ private:
     } state_t;
 
 private:
+    /// Where the player state is placed
+    const SidAllocator *m_allocator;
+
     /// Commodore 64 emulator
     c64 m_c64;
 
@@ -93,6 +99,12 @@ private:
     /// PAL/NTSC switch value
     uint8_t videoSwitch;
 
+    /// Dispatched events, wrapping around
+    uint_least32_t m_eventCount;
+
+    /// Length of a play batch in cycles, 0 to run events
+    event_clock_t m_batchCycles;
+
 private:
     /**
      * Get the C64 model for the current loaded tune.
@@ -105,9 +117,10 @@ private:
     /**
      * Initialize the emulation.
      *
+     * @param seed the random seed, 0 to keep the current sequences
      * @throw configError
      */
-    void initialise();
+    void initialise(uint_least32_t seed);
 
     /**
      * Release the SID builders.
@@ -130,15 +143,35 @@ private:
      * @param sampling the sampling method to use
      * @param fastSampling true to enable fast low quality resampling (only for reSID)
      */
-    void sidParams(double cpuFreq, int frequency,
+    void sidParams(double cpuFreq, double frequency,
                     SidConfig::sampling_method_t sampling, bool fastSampling);
 
     inline void run(unsigned int events);
 
+    /**
+     * Run the emulation for a batch of samples.
+     */
+    inline void runBatch();
+
+    /**
+     * Create a player with the same ROMs as the prototype.
+     */
+    Player(const Player &prototype);
+
 public:
-    Player();
+    /**
+     * @param allocator where to place the player state, nullptr for the heap
+     */
+    Player(const SidAllocator *allocator = nullptr);
     ~Player() {}
 
+    /**
+     * Create an independent player ready to play the same tune.
+     *
+     * @return the new player, nullptr on error
+     */
+    Player *clone() const;
+
     const SidConfig &config() const { return m_cfg; }
 
     const SidInfo &info() const { return m_info; }
@@ -161,6 +194,8 @@ public:
 
     void mute(unsigned int sidNum, unsigned int voice, bool enable);
 
+    bool isMuted(unsigned int sidNum, unsigned int voice) const;
+
     const char *error() const { return m_errorString; }
 
     void setKernal(const uint8_t* rom);
@@ -170,6 +205,15 @@ public:
     uint_least16_t getCia1TimerA() const { return m_c64.getCia1TimerA(); }
 
     bool getSidStatus(unsigned int sidNum, uint8_t regs[32]);
+
+    void getCpuStatus(uint8_t regs[7]) const { m_c64.getCpuStatus(regs); }
+
+    void memoryUsage(size_t &privateBytes, size_t &sharedBytes) const;
+
+    bool probe(uint_least32_t ms, SidProbe &result);
+
+    uint_least32_t replay(const SidWrite *writes, unsigned int n,
+                          short *buffer, uint_least32_t count, unsigned int &applied);
 };
 
 }
@@ -34,6 +34,19 @@
 #include "reloc65.h"
 #include "c64/CPU/mos6510.h"
 
+#include "sidcxx11.h"
+
+#include <map>
+#include <vector>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_CXX11
+#  include <mutex>
+#endif
+
 namespace libsidplayfp
 {
 
@@ -41,7 +54,7 @@ namespace libsidplayfp
 const char ERR_PSIDDRV_NO_SPACE[]  = "ERROR: No space to install psid driver in C64 ram";
 const char ERR_PSIDDRV_RELOC[]     = "ERROR: Failed whilst relocating psid driver";
 
-uint8_t psid_driver[] =
+const uint8_t psid_driver[] =
 {
 #  include "psiddrv.bin"
 };
@@ -60,54 +73,109 @@ const uint8_t POWERON[] =
  * - rle count byte (bit 7 indicates compression used)
  * - data (single byte) or quantity represented by uncompressed count
  * all counts and offsets are 1 less than they should be
+ *
+ * The pattern is decoded once into contiguous runs.
  */
-void copyPoweronPattern(sidmemory& mem)
+class poweronImage
 {
-    uint_least16_t addr = 0;
-    for (unsigned int i = 0; i < sizeof(POWERON);)
+public:
+    typedef std::pair<uint_least16_t, unsigned int> run_t;
+
+public:
+    uint8_t ram[0x10000];
+
+    /// Start address and length of the written areas
+    std::vector<run_t> runs;
+
+public:
+    poweronImage()
     {
-        uint8_t off   = POWERON[i++];
-        uint8_t count = 0;
-        bool compressed = false;
+        std::vector<bool> written(0x10000, false);
 
-        // Determine data count/compression
-        if (off & 0x80)
+        uint_least16_t addr = 0;
+        for (unsigned int i = 0; i < sizeof(POWERON);)
         {
-            // fixup offset
-            off  &= 0x7f;
-            count = POWERON[i++];
-            if (count & 0x80)
+            uint8_t off   = POWERON[i++];
+            uint8_t count = 0;
+            bool compressed = false;
+
+            // Determine data count/compression
+            if (off & 0x80)
             {
-                // fixup count
-                count &= 0x7f;
-                compressed = true;
+                // fixup offset
+                off  &= 0x7f;
+                count = POWERON[i++];
+                if (count & 0x80)
+                {
+                    // fixup count
+                    count &= 0x7f;
+                    compressed = true;
+                }
             }
-        }
 
-        // Fix count off by ones (see format details)
-        count++;
-        addr += off;
+            // Fix count off by ones (see format details)
+            count++;
+            addr += off;
 
-        if (compressed)
-        {
-            // Extract compressed data
-            const uint8_t data = POWERON[i++];
-            while (count-- > 0)
+            if (compressed)
             {
-                mem.writeMemByte(addr++, data);
+                // Extract compressed data
+                const uint8_t data = POWERON[i++];
+                while (count-- > 0)
+                {
+                    written[addr] = true;
+                    ram[addr++] = data;
+                }
             }
-        }
-        else
-        {
-            // Extract uncompressed data
-            while (count-- > 0)
+            else
             {
-                mem.writeMemByte(addr++, POWERON[i++]);
+                // Extract uncompressed data
+                while (count-- > 0)
+                {
+                    written[addr] = true;
+                    ram[addr++] = POWERON[i++];
+                }
             }
         }
+
+        for (unsigned int start = 0; start < 0x10000; start++)
+        {
+            if (!written[start])
+                continue;
+
+            unsigned int end = start;
+            while (end < 0x10000 && written[end])
+                end++;
+
+            runs.push_back(run_t(start, end - start));
+            start = end;
+        }
+    }
+};
+
+void copyPoweronPattern(sidmemory& mem)
+{
+    static const poweronImage image;
+
+    for (std::vector<poweronImage::run_t>::const_iterator it = image.runs.begin(); it != image.runs.end(); ++it)
+    {
+        mem.fillRam(it->first, image.ram + it->first, it->second);
     }
 }
 
+/**
+ * Relocated drivers by relocation address.
+ * The relocation is done once on a private copy
+ * of the driver, which is shared by all the players.
+ */
+typedef std::map<uint_least16_t, std::vector<uint8_t> > relocMap;
+
+static relocMap relocatedDrivers;
+
+#ifdef HAVE_CXX11
+static std::mutex relocLock;
+#endif
+
 uint8_t psiddrv::iomap(uint_least16_t addr) const
 {
     // Force Real C64 Compatibility
@@ -185,14 +253,32 @@ bool psiddrv::drvReloc()
     // Place psid driver into ram
     const uint_least16_t relocAddr = relocStartPage << 8;
 
-    reloc_driver = psid_driver;
-    reloc_size   = sizeof(psid_driver);
-
-    reloc65 relocator(relocAddr - 10);
-    if (!relocator.reloc(&reloc_driver, &reloc_size))
     {
-        m_errorString = ERR_PSIDDRV_RELOC;
-        return false;
+#ifdef HAVE_CXX11
+        std::lock_guard<std::mutex> lock(relocLock);
+#endif
+        relocMap::const_iterator it = relocatedDrivers.find(relocAddr);
+        if (it == relocatedDrivers.end())
+        {
+            std::vector<uint8_t> driver(psid_driver, psid_driver + sizeof(psid_driver));
+
+            unsigned char *buf = &driver[0];
+            int size = static_cast<int>(driver.size());
+
+            reloc65 relocator(relocAddr - 10);
+            if (!relocator.reloc(&buf, &size))
+            {
+                m_errorString = ERR_PSIDDRV_RELOC;
+                return false;
+            }
+
+            // Keep the relocated code only
+            std::vector<uint8_t> code(buf, buf + size);
+            it = relocatedDrivers.insert(relocMap::value_type(relocAddr, code)).first;
+        }
+
+        reloc_driver = &(it->second[0]);
+        reloc_size   = static_cast<int>(it->second.size());
     }
 
     // Adjust size to not include initialisation data.
@@ -36,7 +36,7 @@ private:
     const SidTuneInfo *m_tuneInfo;
     const char *m_errorString;
 
-    uint8_t *reloc_driver;
+    const uint8_t *reloc_driver;
     int      reloc_size;
 
     uint_least16_t m_driverAddr;
@@ -23,15 +23,19 @@
 #ifndef SIDEMU_H
 #define SIDEMU_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidWrite.h"
 #include "sidplayfp/siddefs.h"
 #include "Event.h"
 #include "EventScheduler.h"
 
 #include "c64/c64sid.h"
 
+#include "allocator.h"
 #include "sidcxx11.h"
 
 
@@ -42,16 +46,22 @@ namespace libsidplayfp
 
 /**
  * Inherit this class to create a new SID emulation.
+ * Emulations are placed with the builder's allocator.
  */
-class sidemu : public c64sid
+class sidemu : public c64sid, public allocated
 {
 public:
     /**
-     * Buffer size. 5000 is roughly 5 ms at 96 kHz
+     * Buffer size. 5000 is roughly 5 ms at 96 kHz,
+     * slim builds trade a smaller buffer for more frequent mixing.
      */
     enum
     {
+#ifdef SLIM_ENGINE
+        OUTPUTBUFFERSIZE = 1024
+#else
         OUTPUTBUFFERSIZE = 5000
+#endif
     };
 
 private:
@@ -73,19 +83,37 @@ protected:
     /// Current position in buffer
     int m_bufferpos;
 
+    /// Cycles already run toward the next batched write
+    uint_least32_t m_batchCycles;
+
     bool m_status;
     bool isLocked;
 
+    /// Voices muted with #mute, one bit each
+    uint8_t m_muted;
+
     std::string m_error;
 
+protected:
+    /**
+     * Apply a sequence of timed writes, see #writeBatch.
+     *
+     * @param done set to the number of applied writes
+     * @return false if the emulation does not support it
+     */
+    virtual bool batch(const SidWrite* writes SID_UNUSED, unsigned int n SID_UNUSED,
+        unsigned int &done SID_UNUSED) { return false; }
+
 public:
     sidemu(sidbuilder *builder) :
         m_builder(builder),
         eventScheduler(nullptr),
         m_buffer(nullptr),
         m_bufferpos(0),
+        m_batchCycles(0),
         m_status(true),
         isLocked(false),
+        m_muted(0),
         m_error("N/A") {}
     virtual ~sidemu() {}
 
@@ -111,6 +139,23 @@ public:
      */
     virtual void voice(unsigned int num, bool mute) = 0;
 
+    /**
+     * Mute/unmute voice and keep track of it, see #isMuted.
+     */
+    void mute(unsigned int num, bool muted)
+    {
+        voice(num, muted);
+        if (muted)
+            m_muted |= 1 << num;
+        else
+            m_muted &= ~(1 << num);
+    }
+
+    /**
+     * Check if a voice has been muted with #mute.
+     */
+    bool isMuted(unsigned int num) const { return (m_muted >> num) & 1; }
+
     /**
      * Set SID model.
      */
@@ -127,6 +172,76 @@ public:
     virtual void sampling(float systemfreq SID_UNUSED, float outputfreq SID_UNUSED,
         SidConfig::sampling_method_t method SID_UNUSED, bool fast SID_UNUSED) {}
 
+    /**
+     * Mix a group of chips at clock rate and run a single output
+     * stage per channel instead of one per chip.
+     * The buffers of the first chips in the group then hold
+     * the mixed channels, left or mono first.
+     *
+     * @param chips the chips to mix, this one first
+     * @param matrix the mixing weights scaled by 1 << 16,
+     *        one row of chips.size() values per channel
+     * @param channels the number of output channels
+     * @return false if the emulation does not support it
+     */
+    virtual bool shareOutput(const std::vector<sidemu*>& chips SID_UNUSED,
+        const std::vector<int_least32_t>& matrix SID_UNUSED, unsigned int channels SID_UNUSED) { return false; }
+
+    /**
+     * Undo #shareOutput for the group of this chip,
+     * every chip runs its own output stage again.
+     * The pending output is discarded.
+     */
+    virtual void unshareOutput() {}
+
+    /**
+     * Run the chip through a sequence of register writes,
+     * each one applied after the given number of cycles.
+     *
+     * The chip time advances by the total delay independently
+     * of the scheduler, so this is meant for chips driven by a
+     * replayer rather than by the emulated machine.
+     * The generated samples are appended to the buffer.
+     * When the buffer fills up the call returns early, keeping
+     * the cycles already run toward the next write: the buffer
+     * must be mixed and the call repeated with the remaining writes.
+     * A reset drops the pending cycles.
+     *
+     * @param writes the writes
+     * @param n the number of writes
+     * @param done set to the number of applied writes
+     * @return false if the emulation does not support it
+     */
+    bool writeBatch(const SidWrite* writes, unsigned int n, unsigned int &done)
+    {
+        done = 0;
+        if (!batch(writes, n, done))
+            return false;
+
+        for (unsigned int i = 0; i < done; i++)
+            setStatus(writes[i].addr, writes[i].data);
+
+        return true;
+    }
+
+    /**
+     * Clear the state that a chip reset leaves untouched,
+     * such as the oscillators and the filter state.
+     * The reset must follow.
+     */
+    virtual void powerOn() {}
+
+    /**
+     * Get the memory owned by this emulation, in bytes.
+     */
+    virtual size_t memoryUsage() const = 0;
+
+    /**
+     * Get the memory used by the lookup tables
+     * shared among all the emulations of this kind, in bytes.
+     */
+    virtual size_t sharedMemoryUsage() const { return 0; }
+
     /**
      * Get a detailed error message.
      */
@@ -0,0 +1,84 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDALLOCATOR_H
+#define SIDALLOCATOR_H
+
+#include <stddef.h>
+
+#include "sidplayfp/siddefs.h"
+
+/**
+ * SidAllocator
+ *
+ * A caller supplied memory allocator.
+ *
+ * An engine or a builder constructed with an allocator takes the memory
+ * for its state from it: the C64 with its RAM and ROM patches, the mixer,
+ * the SID emulations with their filters, resamplers and sample buffers.
+ * All the memory of a session can thus come from a single arena,
+ * to be dropped at once after the engine and the builder are deleted.
+ *
+ * Not covered are the process wide tables shared among engines
+ * (see sidplayfp::memoryUsage), the tunes, which may be shared too,
+ * and a few small bookkeeping objects.
+ *
+ * The allocator must outlive the objects using it
+ * and is called from the threads using them.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidAllocator
+{
+public:
+    /**
+     * Allocate memory.
+     *
+     * @param size the number of bytes
+     * @param context the user context
+     * @return memory aligned as for malloc, 0 on failure
+     */
+    typedef void* (*allocate_t)(size_t size, void *context);
+
+    /**
+     * Release memory obtained from #allocate.
+     * Every block is released before the owning object is deleted,
+     * an arena may ignore the calls and drop all the blocks at once.
+     *
+     * @param ptr the memory block
+     * @param context the user context
+     */
+    typedef void (*release_t)(void *ptr, void *context);
+
+public:
+    allocate_t allocate;
+    release_t release;
+
+    /// Passed back to the functions
+    void *context;
+
+public:
+    SidAllocator(allocate_t allocateFunc, release_t releaseFunc, void *ctx = 0) :
+        allocate(allocateFunc),
+        release(releaseFunc),
+        context(ctx) {}
+};
+
+#endif // SIDALLOCATOR_H
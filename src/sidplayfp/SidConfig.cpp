@@ -22,6 +22,9 @@
 
 #include "SidConfig.h"
 
+#include "sidplayfp/sidbuilder.h"
+
+#include "fnvhash.h"
 #include "mixer.h"
 
 #include "sidcxx11.h"
@@ -42,7 +45,9 @@ SidConfig::SidConfig() :
     rightVolume(libsidplayfp::Mixer::VOLUME_MAX),
     powerOnDelay(DEFAULT_POWER_ON_DELAY),
     samplingMethod(RESAMPLE_INTERPOLATE),
-    fastSampling(false)
+    fastSampling(false),
+    sharedResampler(false),
+    seed(0)
 {}
 
 bool SidConfig::compare(const SidConfig &config)
@@ -62,5 +67,32 @@ bool SidConfig::compare(const SidConfig &config)
         || rightVolume != config.rightVolume
         || powerOnDelay != config.powerOnDelay
         || samplingMethod != config.samplingMethod
-        || fastSampling != config.fastSampling;
+        || fastSampling != config.fastSampling
+        || sharedResampler != config.sharedResampler
+        || seed != config.seed;
+}
+
+uint_least64_t SidConfig::hash() const
+{
+    libsidplayfp::fnvHash h;
+    h.add(defaultC64Model);
+    h.add(forceC64Model);
+    h.add(defaultSidModel);
+    h.add(forceSidModel);
+    h.add(digiBoost);
+    h.add(ciaModel);
+    h.add(playback);
+    h.add(frequency);
+    h.add(secondSidAddress);
+    h.add(thirdSidAddress);
+    h.add(sidEmulation != nullptr ? sidEmulation->name() : "");
+    h.add64(sidEmulation != nullptr ? sidEmulation->settingsHash() : 0);
+    h.add(leftVolume);
+    h.add(rightVolume);
+    h.add(powerOnDelay);
+    h.add(samplingMethod);
+    h.add(fastSampling);
+    h.add(sharedResampler);
+    h.add(seed);
+    return h.get();
 }
@@ -75,7 +75,9 @@ public:
     typedef enum
     {
         INTERPOLATE,            ///< Interpolation
-        RESAMPLE_INTERPOLATE    ///< Resampling
+        RESAMPLE_INTERPOLATE,   ///< Resampling
+        CLOCK_RATE,             ///< Clock rate output with integer decimation, available only for reSIDfp @since 2.7
+        RESAMPLE_FAST           ///< Cheap anti-aliased resampling, available only for reSIDfp @since 2.7
     } sampling_method_t;
 
 public:
@@ -127,6 +129,9 @@ public:
 
     /**
      * Sampling frequency.
+     * With the CLOCK_RATE sampling method the CPU clock is divided
+     * by the closest integer factor, the actual output rate
+     * is reported by SidInfo::sampleRate().
      */
     uint_least32_t frequency;
 
@@ -170,6 +175,25 @@ public:
      */
     bool fastSampling;
 
+    /**
+     * Mix multiple SID chips at clock rate and run
+     * a single external filter and resampler per channel,
+     * available only for reSIDfp.
+     *
+     * @since 2.7
+     */
+    bool sharedResampler;
+
+    /**
+     * Seed for the emulation randomness, such as random power on delays.
+     * With a non zero seed every song start is reproducible and
+     * identical configurations produce identical output.
+     * Zero seeds from the system clock.
+     *
+     * @since 2.7
+     */
+    uint_least32_t seed;
+
     /**
      * Compare two config objects.
      *
@@ -177,6 +201,21 @@ public:
      */
     bool compare(const SidConfig &config);
 
+    /**
+     * Get a hash of the settings affecting the output.
+     * The value does not depend on the platform or on the run,
+     * the emulation is identified by its name and the settings
+     * applied to the builder, see sidbuilder::settingsHash().
+     * The emulation may change between library versions, add the
+     * version to the key if the hashes are stored. The ROM images
+     * and the muted voices are not part of the configuration,
+     * see SidInfo::romDigest() and sidplayfp::isMuted().
+     *
+     * @return the 64 bit hash
+     * @since 2.7
+     */
+    uint_least64_t hash() const;
+
 public:
     SidConfig();
 };
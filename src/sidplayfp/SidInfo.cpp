@@ -34,6 +34,8 @@ unsigned int SidInfo::maxsids() const { return getMaxsids(); }
 
 unsigned int SidInfo::channels() const { return getChannels(); }
 
+double SidInfo::sampleRate() const { return getSampleRate(); }
+
 uint_least16_t SidInfo::driverAddr() const { return getDriverAddr(); }
 
 uint_least16_t SidInfo::driverLength() const { return getDriverLength(); }
@@ -45,3 +47,5 @@ const char *SidInfo::speedString() const { return getSpeedString(); }
 const char *SidInfo::kernalDesc() const { return getKernalDesc(); }
 const char *SidInfo::basicDesc() const { return getBasicDesc(); }
 const char *SidInfo::chargenDesc() const { return getChargenDesc(); }
+
+uint_least64_t SidInfo::romDigest() const { return getRomDigest(); }
@@ -51,6 +51,9 @@ public:
     /// Number of output channels (1-mono, 2-stereo)
     unsigned int channels() const;
 
+    /// Actual output sampling rate, 0 if not known @since 2.7
+    double sampleRate() const;
+
     /// Address of the driver
     uint_least16_t driverAddr() const;
 
@@ -70,6 +73,9 @@ public:
     const char *chargenDesc() const;
     //@}
 
+    /// Digest of the loaded ROM images, telling apart also the unknown ones, 0 if not known @since 2.7
+    uint_least64_t romDigest() const;
+
 private:
     virtual const char *getName() const =0;
 
@@ -82,6 +88,9 @@ private:
 
     virtual unsigned int getChannels() const =0;
 
+    // Not pure, so existing implementations keep building
+    virtual double getSampleRate() const { return 0.; }
+
     virtual uint_least16_t getDriverAddr() const =0;
 
     virtual uint_least16_t getDriverLength() const =0;
@@ -94,6 +103,8 @@ private:
     virtual const char *getBasicDesc() const =0;
     virtual const char *getChargenDesc() const =0;
 
+    virtual uint_least64_t getRomDigest() const { return 0; }
+
 protected:
     ~SidInfo() {}
 };
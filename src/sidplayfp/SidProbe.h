@@ -0,0 +1,93 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDPROBE_H
+#define SIDPROBE_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+/**
+ * SidProbe
+ *
+ * The activity and emulation cost of a tune,
+ * as measured by sidplayfp::probe().
+ * The rates are per second of emulated time.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidProbe
+{
+public:
+    /// Emulated time, in milliseconds
+    uint_least32_t timeMs;
+
+    /// Emulated CPU cycles
+    uint_least64_t cpuCycles;
+
+    /**
+     * CPU cycles spent in the player driver, estimated by sampling.
+     * This is where a PSID waits between the play calls;
+     * RSID tunes usually never get back to the driver.
+     */
+    uint_least64_t idleCycles;
+
+    /// IRQ requests
+    double irqRate;
+
+    /// NMI requests
+    double nmiRate;
+
+    /// Writes to the SID registers, all chips included
+    double sidWriteRate;
+
+    /// Events dispatched by the scheduler
+    double eventRate;
+
+    /// Number of emulated SID chips
+    unsigned int sidChips;
+
+    /// Number of SID chips written to during the probe
+    unsigned int sidChipsUsed;
+
+    /**
+     * Emulated time over the elapsed wall clock time,
+     * greater than 1 if faster than real time.
+     * The SIDs are clocked but no samples are mixed, so
+     * rendering is expected to be slightly slower.
+     */
+    double realtimeFactor;
+
+public:
+    SidProbe() :
+        timeMs(0),
+        cpuCycles(0),
+        idleCycles(0),
+        irqRate(0.),
+        nmiRate(0.),
+        sidWriteRate(0.),
+        eventRate(0.),
+        sidChips(0),
+        sidChipsUsed(0),
+        realtimeFactor(0.) {}
+};
+
+#endif // SIDPROBE_H
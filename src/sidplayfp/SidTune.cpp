@@ -99,6 +99,23 @@ void SidTune::load(LoaderFunc loader, const char* fileName, bool separatorIsSlas
     }
 }
 
+void SidTune::load(const SidTuneArchive& archive, const char* fileName)
+{
+    try
+    {
+        delete tune;
+        tune = SidTuneBase::load(archive, fileName, fileNameExtensions);
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        tune =  nullptr;
+        m_status = false;
+        m_statusString = e.message();
+    }
+}
+
 void SidTune::read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
 {
     try
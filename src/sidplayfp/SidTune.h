@@ -29,6 +29,7 @@
 #include "sidplayfp/siddefs.h"
 
 class SidTuneInfo;
+class SidTuneArchive;
 
 namespace libsidplayfp
 {
@@ -132,6 +133,16 @@ public:  // ----------------------------------------------------------------
      */
     void load(LoaderFunc loader, const char* fileName, bool separatorIsSlash = false);
 
+    /**
+     * Load a sidtune into an existing object from an archive.
+     * The archive must stay open while the tune is in use.
+     *
+     * @param archive the open archive
+     * @param fileName path of the tune inside the archive
+     * @since 2.7
+     */
+    void load(const SidTuneArchive& archive, const char* fileName);
+
     /**
      * Load a sidtune into an existing object from a buffer.
      *
@@ -0,0 +1,66 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidTuneArchive.h"
+
+#include "sidtune/tarIndex.h"
+
+SidTuneArchive::SidTuneArchive() :
+    index(*(new libsidplayfp::tarIndex)) {}
+
+SidTuneArchive::~SidTuneArchive()
+{
+    delete &index;
+}
+
+bool SidTuneArchive::open(const char* fileName)
+{
+    return index.open(fileName);
+}
+
+void SidTuneArchive::close()
+{
+    index.close();
+}
+
+unsigned int SidTuneArchive::entries() const
+{
+    return index.entries();
+}
+
+const char* SidTuneArchive::path(unsigned int i) const
+{
+    return i < index.entries() ? index.path(i) : nullptr;
+}
+
+const uint_least8_t* SidTuneArchive::data(unsigned int i, uint_least32_t& length) const
+{
+    return i < index.entries() ? index.data(i, length) : nullptr;
+}
+
+const uint_least8_t* SidTuneArchive::find(const char* path, uint_least32_t& length) const
+{
+    return index.find(path, length);
+}
+
+const char* SidTuneArchive::error() const
+{
+    return index.error();
+}
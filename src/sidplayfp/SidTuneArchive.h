@@ -0,0 +1,110 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDTUNEARCHIVE_H
+#define SIDTUNEARCHIVE_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+namespace libsidplayfp
+{
+class tarIndex;
+}
+
+/**
+ * A collection of sidtunes packed in a single uncompressed tar file,
+ * e.g. an unpacked HVSC release repacked with
+ * `tar cf C64Music.tar C64Music`.
+ *
+ * The archive is memory mapped and indexed once on open, lookups
+ * are a binary search on the path. Entry data is accessed
+ * in place without copying.
+ * Tunes loaded from an archive with SidTune::load may reference
+ * the archive data, so the archive must stay open as long as
+ * they are in use.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidTuneArchive
+{
+private:
+    libsidplayfp::tarIndex &index;
+
+public:
+    SidTuneArchive();
+    ~SidTuneArchive();
+
+    /**
+     * Open an archive.
+     *
+     * @param fileName the tar file
+     * @return false in case of errors, true otherwise.
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Close the archive.
+     */
+    void close();
+
+    /**
+     * Number of files in the archive.
+     */
+    unsigned int entries() const;
+
+    /**
+     * Path of the selected file.
+     *
+     * @param i the entry index, entries are sorted by path
+     */
+    const char* path(unsigned int i) const;
+
+    /**
+     * Contents of the selected file.
+     *
+     * @param i the entry index, entries are sorted by path
+     * @param length the file length
+     */
+    const uint_least8_t* data(unsigned int i, uint_least32_t& length) const;
+
+    /**
+     * Look up a file.
+     * Paths use '/' as separator, leading "./" and "/" are ignored.
+     *
+     * @param path the file path inside the archive
+     * @param length the file length
+     * @return pointer to the file contents, 0 if not found
+     */
+    const uint_least8_t* find(const char* path, uint_least32_t& length) const;
+
+    /**
+     * Get descriptive error message.
+     */
+    const char* error() const;
+
+private:
+    // prevent copying
+    SidTuneArchive(const SidTuneArchive&);
+    SidTuneArchive& operator=(const SidTuneArchive&);
+};
+
+#endif // SIDTUNEARCHIVE_H
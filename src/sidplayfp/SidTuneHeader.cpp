@@ -0,0 +1,101 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidTuneHeader.h"
+
+#include "sidtune/PSID.h"
+
+#include "sidcxx11.h"
+
+using namespace libsidplayfp;
+
+const char TXT_NO_ERRORS[] = "No errors";
+const char TXT_NA[]        = "N/A";
+
+SidTuneHeader::SidTuneHeader()
+{
+    clear();
+}
+
+void SidTuneHeader::clear()
+{
+    m_statusString = TXT_NA;
+    m_formatString = TXT_NA;
+    m_speed = 0;
+    m_clockSpeed = SidTuneInfo::CLOCK_UNKNOWN;
+    m_compatibility = SidTuneInfo::COMPATIBILITY_C64;
+    m_sidChips = 0;
+    m_version = 0;
+    m_songs = 0;
+    m_startSong = 0;
+    m_dataOffset = 0;
+    m_loadAddr = 0;
+    m_initAddr = 0;
+    m_playAddr = 0;
+    m_relocStartPage = 0;
+    m_relocPages = 0;
+    m_status = false;
+    m_musPlayer = false;
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        m_infoString[i][0] = '\0';
+    }
+}
+
+bool SidTuneHeader::read(const uint_least8_t* buffer, uint_least32_t bufferLen)
+{
+    const char* error = PSID::readHeader(buffer, bufferLen, *this);
+    if (error != nullptr)
+    {
+        clear();
+        m_statusString = error;
+    }
+    else
+    {
+        m_status = true;
+        m_statusString = TXT_NO_ERRORS;
+    }
+
+    return m_status;
+}
+
+int SidTuneHeader::songSpeed(unsigned int song) const
+{
+    if (song == 0 || song > m_songs)
+        song = m_startSong ? m_startSong : 1;
+
+    // Same evaluation as SidTuneBase::selectSong
+    unsigned int bit;
+    switch (m_compatibility)
+    {
+    case SidTuneInfo::COMPATIBILITY_R64:
+        return SidTuneInfo::SPEED_CIA_1A;
+    case SidTuneInfo::COMPATIBILITY_PSID:
+        bit = (song - 1) & 31;
+        break;
+    default:
+        // All tunes above 32 use the same song speed as tune 32
+        bit = (song > 32) ? 31 : song - 1;
+        break;
+    }
+
+    return ((m_speed >> bit) & 1) ? SidTuneInfo::SPEED_CIA_1A : SidTuneInfo::SPEED_VBI;
+}
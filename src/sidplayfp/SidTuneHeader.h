@@ -0,0 +1,233 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDTUNEHEADER_H
+#define SIDTUNEHEADER_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+#include "sidplayfp/SidTuneInfo.h"
+
+namespace libsidplayfp
+{
+class PSID;
+}
+
+/**
+ * Lightweight PSID/RSID header decoder.
+ *
+ * Validates and decodes a version 1 to 4 header directly from a caller
+ * owned buffer. Nothing is copied apart from the three info strings,
+ * which are kept in fixed size inline storage, and no memory
+ * is allocated, so an instance can be reused for scanning
+ * large collections.
+ * Use SidTune to actually load and play a tune.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidTuneHeader
+{
+    friend class libsidplayfp::PSID;
+
+public:
+    /// Maximum number of SID chips described by a header.
+    static const unsigned int MAX_SIDS = 3;
+
+    /// Size of the info string fields.
+    static const unsigned int INFO_STRING_LEN = 32;
+
+private:
+    const char* m_statusString;
+
+    const char* m_formatString;
+
+    uint_least32_t m_speed;
+
+    SidTuneInfo::clock_t m_clockSpeed;
+
+    SidTuneInfo::compatibility_t m_compatibility;
+
+    SidTuneInfo::model_t m_sidModels[MAX_SIDS];
+
+    uint_least16_t m_sidChipAddresses[MAX_SIDS];
+
+    unsigned int m_sidChips;
+
+    unsigned int m_version;
+
+    unsigned int m_songs;
+    unsigned int m_startSong;
+
+    uint_least16_t m_dataOffset;
+
+    uint_least16_t m_loadAddr;
+    uint_least16_t m_initAddr;
+    uint_least16_t m_playAddr;
+
+    uint_least8_t m_relocStartPage;
+    uint_least8_t m_relocPages;
+
+    bool m_status;
+
+    bool m_musPlayer;
+
+    char m_infoString[3][INFO_STRING_LEN + 1];
+
+private:
+    void clear();
+
+public:
+    SidTuneHeader();
+
+    /**
+     * Decode a PSID/RSID header.
+     *
+     * The buffer is only accessed during the call.
+     *
+     * @param buffer the file contents, at least the header
+     *        plus the two bytes following it
+     * @param bufferLen length of the buffer
+     * @return false if the data is not a valid PSID/RSID header
+     */
+    bool read(const uint_least8_t* buffer, uint_least32_t bufferLen);
+
+    /**
+     * Determine current state of object.
+     *
+     * @return true if the last read succeeded
+     */
+    bool getStatus() const { return m_status; }
+
+    /**
+     * Error/status message of last operation.
+     */
+    const char* statusString() const { return m_statusString; }
+
+    /**
+     * The name of the identified file format.
+     */
+    const char* formatString() const { return m_formatString; }
+
+    /**
+     * Header version, 1 to 4.
+     */
+    unsigned int version() const { return m_version; }
+
+    /**
+     * Offset of the C64 data in the file.
+     */
+    uint_least16_t dataOffset() const { return m_dataOffset; }
+
+    /**
+     * Load Address as stored in the header,
+     * 0 if it precedes the C64 data.
+     */
+    uint_least16_t loadAddr() const { return m_loadAddr; }
+
+    /**
+     * Init Address.
+     */
+    uint_least16_t initAddr() const { return m_initAddr; }
+
+    /**
+     * Play Address.
+     */
+    uint_least16_t playAddr() const { return m_playAddr; }
+
+    /**
+     * The number of songs.
+     */
+    unsigned int songs() const { return m_songs; }
+
+    /**
+     * The default starting song.
+     */
+    unsigned int startSong() const { return m_startSong; }
+
+    /**
+     * Intended speed of the selected song.
+     *
+     * @param song the song number, 0 for the default starting song
+     * @return SidTuneInfo::SPEED_VBI or SidTuneInfo::SPEED_CIA_1A
+     */
+    int songSpeed(unsigned int song) const;
+
+    /**
+     * The tune clock speed.
+     */
+    SidTuneInfo::clock_t clockSpeed() const { return m_clockSpeed; }
+
+    /**
+     * Compatibility requirements.
+     */
+    SidTuneInfo::compatibility_t compatibility() const { return m_compatibility; }
+
+    /**
+     * The number of SID chips required by the tune.
+     */
+    unsigned int sidChips() const { return m_sidChips; }
+
+    /**
+     * The SID chip base address, 0 if the nth SID is not required.
+     */
+    uint_least16_t sidChipBase(unsigned int i) const
+    {
+        return i < m_sidChips ? m_sidChipAddresses[i] : 0;
+    }
+
+    /**
+     * The SID chip model requested by the sidtune.
+     */
+    SidTuneInfo::model_t sidModel(unsigned int i) const
+    {
+        return i < m_sidChips ? m_sidModels[i] : SidTuneInfo::SIDMODEL_UNKNOWN;
+    }
+
+    /**
+     * First available page for relocation.
+     */
+    uint_least8_t relocStartPage() const { return m_relocStartPage; }
+
+    /**
+     * Number of pages available for relocation.
+     */
+    uint_least8_t relocPages() const { return m_relocPages; }
+
+    /**
+     * Whether the tune contains Compute!'s Sidplayer MUS data.
+     */
+    bool isMus() const { return m_musPlayer; }
+
+    /**
+     * @name Tune infos
+     * - 0 = Title
+     * - 1 = Author
+     * - 2 = Released
+     *
+     * @return a zero terminated string, 0 if out of range
+     */
+    const char* infoString(unsigned int i) const
+    {
+        return i < 3 ? m_infoString[i] : 0;
+    }
+};
+
+#endif // SIDTUNEHEADER_H
@@ -0,0 +1,46 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDWRITE_H
+#define SIDWRITE_H
+
+#include <stdint.h>
+
+/**
+ * SidWrite
+ *
+ * A timed SID register write, as found in register logs,
+ * see sidplayfp::replay().
+ *
+ * @since 2.7
+ */
+struct SidWrite
+{
+    /// Cycles to run before the write, counted from the previous one
+    uint_least32_t cycles;
+
+    /// Register address
+    uint8_t addr;
+
+    /// Register value
+    uint8_t data;
+};
+
+#endif // SIDWRITE_H
@@ -26,6 +26,9 @@
 #include <set>
 #include <string>
 
+#include <stdint.h>
+
+#include "sidplayfp/SidAllocator.h"
 #include "sidplayfp/SidConfig.h"
 
 namespace libsidplayfp
@@ -45,6 +48,8 @@ protected:
 private:
     const char * const m_name;
 
+    const SidAllocator * const m_allocator;
+
 protected:
     std::string m_errorBuffer;
 
@@ -71,8 +76,14 @@ protected:
     };
 
 public:
-    sidbuilder(const char * const name) :
+    /**
+     * @param name the builder name
+     * @param allocator where to place the emulations, see SidAllocator.
+     *                  0 for the heap. @since 2.7
+     */
+    sidbuilder(const char * const name, const SidAllocator *allocator = 0) :
         m_name(name),
+        m_allocator(allocator),
         m_errorBuffer("N/A"),
         m_status(true) {}
     virtual ~sidbuilder() {}
@@ -128,6 +139,14 @@ public:
      */
     const char *name() const { return m_name; }
 
+    /**
+     * Get the allocator for the emulations.
+     *
+     * @return the allocator, 0 if they are placed on the heap
+     * @since 2.7
+     */
+    const SidAllocator *allocator() const { return m_allocator; }
+
     /**
      * Error message.
      *
@@ -155,6 +174,16 @@ public:
      * @param enable true = enable, false = disable
      */
     virtual void filter(bool enable) = 0;
+
+    /**
+     * Get a hash of the settings applied to the emulations
+     * which affect the output, such as the filter.
+     * Covered by SidConfig::hash().
+     *
+     * @return the hash, 0 if the builder has no such settings
+     * @since 2.7
+     */
+    virtual uint_least64_t settingsHash() const { return 0; }
 };
 
 #endif // SIDBUILDER_H
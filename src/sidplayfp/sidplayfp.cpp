@@ -36,11 +36,23 @@
 sidplayfp::sidplayfp() :
     sidplayer(*(new libsidplayfp::Player)) {}
 
+sidplayfp::sidplayfp(const SidAllocator *allocator) :
+    sidplayer(*(new (allocator) libsidplayfp::Player(allocator))) {}
+
+sidplayfp::sidplayfp(libsidplayfp::Player &player) :
+    sidplayer(player) {}
+
 sidplayfp::~sidplayfp()
 {
     delete &sidplayer;
 }
 
+sidplayfp *sidplayfp::clone() const
+{
+    libsidplayfp::Player *player = sidplayer.clone();
+    return player != nullptr ? new sidplayfp(*player) : nullptr;
+}
+
 bool sidplayfp::config(const SidConfig &cfg)
 {
     return sidplayer.config(cfg);
@@ -96,6 +108,11 @@ void sidplayfp::mute(unsigned int sidNum, unsigned int voice, bool enable)
     sidplayer.mute(sidNum, voice, enable);
 }
 
+bool sidplayfp::isMuted(unsigned int sidNum, unsigned int voice) const
+{
+    return sidplayer.isMuted(sidNum, voice);
+}
+
 void sidplayfp::debug(bool enable, FILE *out)
 {
     sidplayer.debug(enable, out);
@@ -126,3 +143,24 @@ bool sidplayfp::getSidStatus(unsigned int sidNum, uint8_t regs[32])
 {
     return sidplayer.getSidStatus(sidNum, regs);
 }
+
+void sidplayfp::getCpuStatus(uint8_t regs[7]) const
+{
+    sidplayer.getCpuStatus(regs);
+}
+
+void sidplayfp::memoryUsage(size_t &privateBytes, size_t &sharedBytes) const
+{
+    sidplayer.memoryUsage(privateBytes, sharedBytes);
+}
+
+bool sidplayfp::probe(uint_least32_t ms, SidProbe &result)
+{
+    return sidplayer.probe(ms, result);
+}
+
+uint_least32_t sidplayfp::replay(const SidWrite *writes, unsigned int n,
+                                 short *buffer, uint_least32_t count, unsigned int &applied)
+{
+    return sidplayer.replay(writes, n, buffer, count, applied);
+}
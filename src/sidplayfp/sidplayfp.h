@@ -29,9 +29,12 @@
 #include "sidplayfp/siddefs.h"
 #include "sidplayfp/sidversion.h"
 
+class  SidAllocator;
 class  SidConfig;
 class  SidTune;
 class  SidInfo;
+class  SidProbe;
+struct SidWrite;
 class  EventContext;
 
 // Private Sidplayer
@@ -48,10 +51,49 @@ class SID_EXTERN sidplayfp
 private:
     libsidplayfp::Player &sidplayer;
 
+private:
+    sidplayfp(libsidplayfp::Player &player);
+
 public:
     sidplayfp();
+
+    /**
+     * Create an engine which places its state with the given allocator,
+     * see SidAllocator. The SIDs come from the builder set in the
+     * configuration, which takes its own allocator.
+     * Clones share the allocator.
+     *
+     * @param allocator the allocator, must outlive the engine
+     * @since 2.7
+     */
+    explicit sidplayfp(const SidAllocator *allocator);
+
     ~sidplayfp();
 
+    /**
+     * Create an independent engine from this one.
+     *
+     * The new engine shares the ROM images, already identified,
+     * the configuration, the SID builder and the loaded tune,
+     * which must outlive it. It gets its own C64 and SID chips
+     * and starts from the beginning of the current song.
+     * Voice muting is not copied.
+     *
+     * The tune is not copied: the selected song is part of the
+     * SidTune state and is read again whenever an engine restarts.
+     * Engines sharing a tune may play concurrently, as playback only
+     * reads it, but the tune must not be modified (e.g. with
+     * SidTune::selectSong or SidTune::load) while any of them is in
+     * use. Load a separate SidTune for each engine which needs to
+     * play a different song.
+     *
+     * @return the new engine, to be deleted by the caller,
+     *         or nullptr if the SIDs could not be created
+     *         (e.g. the builder has no free chips left).
+     * @since 2.7
+     */
+    sidplayfp *clone() const;
+
     /**
      * Get the current engine configuration.
      *
@@ -141,6 +183,16 @@ public:
      */
     void mute(unsigned int sidNum, unsigned int voice, bool enable);
 
+    /**
+     * Check if a SID channel has been muted with #mute.
+     *
+     * @param sidNum the SID chip, 0 for the first one, 1 for the second.
+     * @param voice the channel.
+     * @return true if muted, false otherwise or if the chip doesn't exist.
+     * @since 2.7
+     */
+    bool isMuted(unsigned int sidNum, unsigned int voice) const;
+
     /**
      * Get the current playing time.
      *
@@ -191,6 +243,74 @@ public:
      * @since 2.2
      */
     bool getSidStatus(unsigned int sidNum, uint8_t regs[32]);
+
+    /**
+     * Get the CPU registers.
+     *
+     * @param regs an array that will be filled with the current values of
+     *        PC low, PC high, A, X, Y, SP and the status flags (NV-DIZC).
+     * @since 2.7
+     */
+    void getCpuStatus(uint8_t regs[7]) const;
+
+    /**
+     * Get the memory used by the engine.
+     * The private part is owned by this engine alone, including
+     * the C64 and its SID emulations; the shared part covers the
+     * lookup tables and ROM images shared by all the engines
+     * in the process. Small allocations such as the info strings
+     * are not accounted.
+     * See the README for how to reduce the per-engine memory.
+     *
+     * @param privateBytes set to the memory owned by this engine, in bytes
+     * @param sharedBytes set to the memory of the shared tables, in bytes
+     * @since 2.7
+     */
+    void memoryUsage(size_t &privateBytes, size_t &sharedBytes) const;
+
+    /**
+     * Estimate the emulation cost of the loaded tune.
+     * The tune is played for a short time with the current
+     * configuration, clocking the SIDs without producing samples,
+     * and the activity of the emulated machine is measured.
+     * The tune is restarted afterwards, as after #stop().
+     * To estimate the cost with another configuration,
+     * e.g. a different number of SIDs or clock speed,
+     * apply it with #config() before probing.
+     * Check #error for detailed message if something goes wrong.
+     *
+     * @param ms the emulated time to play, in milliseconds,
+     *        a few seconds give stable results
+     * @param result set to the measured metrics
+     * @return true on success, false otherwise.
+     * @since 2.7
+     */
+    bool probe(uint_least32_t ms, SidProbe &result);
+
+    /**
+     * Replay timed SID register writes, e.g. from a register log.
+     * The writes drive the SID directly while the emulated machine
+     * is stopped, so the configuration must have a single SID
+     * and a tune must be loaded to set it up.
+     * The samples are mixed as by #play(). When the buffer is full
+     * the call returns early and must be repeated with the remaining
+     * writes, or with none to get the samples still pending after
+     * the last one; the cycles already run toward the next write are kept.
+     * The tune restarts at the next #play(), as after #stop().
+     * Hardware emulations send the writes to the device.
+     * Check #error for detailed message if something goes wrong.
+     *
+     * @param writes the writes
+     * @param n the number of writes
+     * @param buffer pointer to the buffer to fill with samples
+     * @param count the size of the buffer measured in 16 bit samples
+     * @param applied set to the number of applied writes,
+     *        less than n if the buffer filled up or in case of errors
+     * @return the number of produced samples
+     * @since 2.7
+     */
+    uint_least32_t replay(const SidWrite *writes, unsigned int n,
+                          short *buffer, uint_least32_t count, unsigned int &applied);
 };
 
 #endif // SIDPLAYFP_H
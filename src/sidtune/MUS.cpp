@@ -22,7 +22,9 @@
 
 #include "MUS.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "sidplayfp/SidTuneInfo.h"
 
@@ -137,34 +139,41 @@ bool MUS::mergeParts(buffer_t& musBuf, buffer_t& strBuf)
 }
 
 /**
- * Replace useless SID reads with NOPs.
+ * Copy a player image, replace useless SID reads with NOPs
+ * and point the player to its data.
  */
-void removeReads(sidmemory& mem, uint_least16_t dest)
+void patchPlayer(std::vector<uint8_t>& image, const uint8_t* player, size_t size, uint_least16_t dataAddr)
 {
+    image.assign(player + 2, player + size);
+
     const int sid_read_offset = 0x424 - o65headersize - 2;
-    mem.fillRam(dest + sid_read_offset, 0xea, 12);
+    std::fill(image.begin() + sid_read_offset, image.begin() + sid_read_offset + 12, 0xea);
+
+    image[0xc6e] = dataAddr & 0xFF;
+    image[0xc70] = dataAddr >> 8;
+}
+
+void MUS::preparePlayer()
+{
+    // Player #1 plays data #1.
+    patchPlayer(player1Image, player1, player1size, SIDTUNE_MUS_DATA_ADDR + 2);
+
+    if (info->getSidChips() > 1)
+    {
+        // Player #2 plays data #2.
+        patchPlayer(player2Image, player2, player2size, SIDTUNE_MUS_DATA_ADDR + musDataLen + 2);
+    }
 }
 
 void MUS::installPlayer(sidmemory& mem)
 {
     // Install MUS player #1.
-    uint_least16_t dest = endian_16(player1[1], player1[0]);
+    mem.fillRam(endian_16(player1[1], player1[0]), &player1Image[0], player1Image.size());
 
-    mem.fillRam(dest, player1 + 2, player1size - 2);
-    removeReads(mem, dest);
-    // Point player #1 to data #1.
-    mem.writeMemByte(dest + 0xc6e, (SIDTUNE_MUS_DATA_ADDR + 2) & 0xFF);
-    mem.writeMemByte(dest + 0xc70, (SIDTUNE_MUS_DATA_ADDR + 2) >> 8);
-
-    if (info->getSidChips() > 1)
+    if (!player2Image.empty())
     {
         // Install MUS player #2.
-        dest = endian_16(player2[1], player2[0]);
-        mem.fillRam(dest, player2 + 2, player2size - 2);
-        removeReads(mem, dest);
-        // Point player #2 to data #2.
-        mem.writeMemByte(dest + 0xc6e, (SIDTUNE_MUS_DATA_ADDR + musDataLen + 2) & 0xFF);
-        mem.writeMemByte(dest + 0xc70, (SIDTUNE_MUS_DATA_ADDR + musDataLen + 2) >> 8);
+        mem.fillRam(endian_16(player2[1], player2[0]), &player2Image[0], player2Image.size());
     }
 }
 
@@ -186,6 +195,7 @@ SidTuneBase* MUS::load(buffer_t& musBuf,
     std::unique_ptr<MUS> tune(new MUS());
     tune->tryLoad(musBuf, strBuf, fileOffset, voice3Index, init);
     tune->mergeParts(musBuf, strBuf);
+    tune->preparePlayer();
 
     return tune.release();
 }
@@ -36,9 +36,23 @@ private:
     /// Needed for MUS/STR player installation.
     uint_least16_t musDataLen;
 
+    /**
+     * Player images, relocated and patched once at load time.
+     * Only the patching is cached: the music data and the players
+     * sit in separate areas around the driver and the rest of RAM,
+     * so each placement still copies the data and each player
+     * as separate blocks.
+     */
+    //@{
+    buffer_t player1Image;
+    buffer_t player2Image;
+    //@}
+
 private:
     bool mergeParts(buffer_t& musBuf, buffer_t& strBuf);
 
+    void preparePlayer();
+
     void tryLoad(buffer_t& musBuf,
                     buffer_t& strBuf,
                     uint_least32_t fileOffset,
@@ -47,28 +47,27 @@ const int PSID_MAXSTRLEN = 32;
 //     load address cannot be less than $07E8
 //     info strings may be 32 characters long without trailing zero
 
-struct psidHeader           // all values are big-endian
-{
-    uint32_t id;                   // 'PSID' or 'RSID' (ASCII)
-    uint16_t version;              // 1, 2, 3 or 4
-    uint16_t data;                 // 16-bit offset to binary data in file
-    uint16_t load;                 // 16-bit C64 address to load file to
-    uint16_t init;                 // 16-bit C64 address of init subroutine
-    uint16_t play;                 // 16-bit C64 address of play subroutine
-    uint16_t songs;                // number of songs
-    uint16_t start;                // start song out of [1..256]
-    uint32_t speed;                // 32-bit speed info
-                                   // bit: 0=50 Hz, 1=CIA 1 Timer A (default: 60 Hz)
-    char name[PSID_MAXSTRLEN];     // ASCII strings, 31 characters long and
-    char author[PSID_MAXSTRLEN];   // terminated by a trailing zero
-    char released[PSID_MAXSTRLEN]; //
-
-    uint16_t flags;                // only version >= 2
-    uint8_t relocStartPage;        // only version >= 2ng
-    uint8_t relocPages;            // only version >= 2ng
-    uint8_t sidChipBase2;          // only version >= 3
-    uint8_t sidChipBase3;          // only version >= 4
-};
+// Header layout, all values are big-endian
+//
+// offset  size
+//   0      4   id          'PSID' or 'RSID' (ASCII)
+//   4      2   version     1, 2, 3 or 4
+//   6      2   data        16-bit offset to binary data in file
+//   8      2   load        16-bit C64 address to load file to
+//  10      2   init        16-bit C64 address of init subroutine
+//  12      2   play        16-bit C64 address of play subroutine
+//  14      2   songs       number of songs
+//  16      2   start       start song out of [1..256]
+//  18      4   speed       32-bit speed info
+//                          bit: 0=50 Hz, 1=CIA 1 Timer A (default: 60 Hz)
+//  22     32   name        ASCII strings, 31 characters long and
+//  54     32   author      terminated by a trailing zero
+//  86     32   released
+// 118      2   flags           only version >= 2
+// 120      1   relocStartPage  only version >= 2ng
+// 121      1   relocPages      only version >= 2ng
+// 122      1   sidChipBase2    only version >= 3
+// 123      1   sidChipBase3    only version >= 4
 
 enum
 {
@@ -100,6 +99,7 @@ const char TXT_FORMAT_PSID[]  = "PlaySID one-file format (PSID)";
 const char TXT_FORMAT_RSID[]  = "Real C64 one-file format (RSID)";
 const char TXT_UNKNOWN_PSID[] = "Unsupported PSID version";
 const char TXT_UNKNOWN_RSID[] = "Unsupported RSID version";
+const char TXT_NOT_PSID[]     = "Not a PSID or RSID file";
 
 const int psid_headerSize = 118;
 const int psidv2_headerSize = psid_headerSize + 6;
@@ -143,78 +143,57 @@ bool validateAddress(uint_least8_t address)
     return true;
 }
 
+bool PSID::isPSID(const uint_least8_t* data)
+{
+    const uint32_t magic = endian_big32(data);
+    return (magic == PSID_ID) || (magic == RSID_ID);
+}
+
 SidTuneBase* PSID::load(buffer_t& dataBuf)
 {
     // File format check
-    if (dataBuf.size() < 4)
+    if ((dataBuf.size() < 4) || !isPSID(&dataBuf[0]))
     {
         return nullptr;
     }
 
-    const uint32_t magic = endian_big32(&dataBuf[0]);
-    if ((magic != PSID_ID)
-        && (magic != RSID_ID))
+    return load(&dataBuf[0], dataBuf.size());
+}
+
+SidTuneBase* PSID::load(const uint_least8_t* data, uint_least32_t size)
+{
+    SidTuneHeader header;
+    const char* error = readHeader(data, size, header);
+    if (error != nullptr)
     {
-        return nullptr;
+        throw loadError(error);
     }
 
-    psidHeader pHeader;
-    readHeader(dataBuf, pHeader);
-
     std::unique_ptr<PSID> tune(new PSID());
-    tune->tryLoad(pHeader);
+    tune->tryLoad(header);
 
     return tune.release();
 }
 
-void PSID::readHeader(const buffer_t &dataBuf, psidHeader &hdr)
+const char* PSID::readHeader(const uint_least8_t* data, uint_least32_t size, SidTuneHeader &hdr)
 {
     // Due to security concerns, input must be at least as long as version 1
     // header plus 16-bit C64 load address. That is the area which will be
     // accessed.
-    if (dataBuf.size() < (psid_headerSize + 2))
+    if (size < (psid_headerSize + 2))
     {
-        throw loadError(ERR_TRUNCATED);
+        return ERR_TRUNCATED;
     }
 
-    // Read v1 fields
-    hdr.id               = endian_big32(&dataBuf[0]);
-    hdr.version          = endian_big16(&dataBuf[4]);
-    hdr.data             = endian_big16(&dataBuf[6]);
-    hdr.load             = endian_big16(&dataBuf[8]);
-    hdr.init             = endian_big16(&dataBuf[10]);
-    hdr.play             = endian_big16(&dataBuf[12]);
-    hdr.songs            = endian_big16(&dataBuf[14]);
-    hdr.start            = endian_big16(&dataBuf[16]);
-    hdr.speed            = endian_big32(&dataBuf[18]);
-    memcpy(hdr.name,     &dataBuf[22], PSID_MAXSTRLEN);
-    memcpy(hdr.author,   &dataBuf[54], PSID_MAXSTRLEN);
-    memcpy(hdr.released, &dataBuf[86], PSID_MAXSTRLEN);
-
-    if (hdr.version >= 2)
-    {
-        if (dataBuf.size() < (psidv2_headerSize + 2))
-        {
-            throw loadError(ERR_TRUNCATED);
-        }
-
-        // Read v2/3/4 fields
-        hdr.flags            = endian_big16(&dataBuf[118]);
-        hdr.relocStartPage   = dataBuf[120];
-        hdr.relocPages       = dataBuf[121];
-        hdr.sidChipBase2     = dataBuf[122];
-        hdr.sidChipBase3     = dataBuf[123];
-    }
-}
+    const uint32_t id = endian_big32(&data[0]);
+    const uint_least16_t version = endian_big16(&data[4]);
 
-void PSID::tryLoad(const psidHeader &pHeader)
-{
     SidTuneInfo::compatibility_t compatibility = SidTuneInfo::COMPATIBILITY_C64;
 
     // Require a valid ID and version number.
-    if (pHeader.id == PSID_ID)
+    if (id == PSID_ID)
     {
-       switch (pHeader.version)
+       switch (version)
        {
        case 1:
            compatibility = SidTuneInfo::COMPATIBILITY_PSID;
@@ -224,49 +203,61 @@ void PSID::tryLoad(const psidHeader &pHeader)
        case 4:
            break;
        default:
-           throw loadError(TXT_UNKNOWN_PSID);
+           return TXT_UNKNOWN_PSID;
        }
-       info->m_formatString = TXT_FORMAT_PSID;
+       hdr.m_formatString = TXT_FORMAT_PSID;
     }
-    else if (pHeader.id == RSID_ID)
+    else if (id == RSID_ID)
     {
-       switch (pHeader.version)
+       switch (version)
        {
        case 2:
        case 3:
        case 4:
            break;
        default:
-           throw loadError(TXT_UNKNOWN_RSID);
+           return TXT_UNKNOWN_RSID;
        }
-       info->m_formatString = TXT_FORMAT_RSID;
+       hdr.m_formatString = TXT_FORMAT_RSID;
        compatibility = SidTuneInfo::COMPATIBILITY_R64;
     }
+    else
+    {
+        return TXT_NOT_PSID;
+    }
 
-    fileOffset             = pHeader.data;
-    info->m_loadAddr       = pHeader.load;
-    info->m_initAddr       = pHeader.init;
-    info->m_playAddr       = pHeader.play;
-    info->m_songs          = pHeader.songs;
-    info->m_startSong      = pHeader.start;
-    info->m_compatibility  = compatibility;
-    info->m_relocPages     = 0;
-    info->m_relocStartPage = 0;
-
-    uint_least32_t speed = pHeader.speed;
-    SidTuneInfo::clock_t clock = SidTuneInfo::CLOCK_UNKNOWN;
+    if ((version >= 2) && (size < (psidv2_headerSize + 2)))
+    {
+        return ERR_TRUNCATED;
+    }
 
-    bool musPlayer = false;
+    hdr.m_version        = version;
+    hdr.m_dataOffset     = endian_big16(&data[6]);
+    hdr.m_loadAddr       = endian_big16(&data[8]);
+    hdr.m_initAddr       = endian_big16(&data[10]);
+    hdr.m_playAddr       = endian_big16(&data[12]);
+    hdr.m_songs          = endian_big16(&data[14]);
+    hdr.m_startSong      = endian_big16(&data[16]);
+    hdr.m_compatibility  = compatibility;
+    hdr.m_relocStartPage = 0;
+    hdr.m_relocPages     = 0;
+    hdr.m_sidChips       = 1;
+    hdr.m_sidChipAddresses[0] = 0xd400;
+    hdr.m_sidModels[0]   = SidTuneInfo::SIDMODEL_UNKNOWN;
+    hdr.m_musPlayer      = false;
+
+    uint_least32_t speed = endian_big32(&data[18]);
+    SidTuneInfo::clock_t clock = SidTuneInfo::CLOCK_UNKNOWN;
 
-    if (pHeader.version >= 2)
+    if (version >= 2)
     {
-        const uint_least16_t flags = pHeader.flags;
+        const uint_least16_t flags = endian_big16(&data[118]);
 
         // Check clock
         if (flags & PSID_MUS)
         {   // MUS tunes run at any speed
             clock = SidTuneInfo::CLOCK_ANY;
-            musPlayer = true;
+            hdr.m_musPlayer = true;
         }
         else
         {
@@ -292,40 +283,42 @@ void PSID::tryLoad(const psidHeader &pHeader)
         {
         case SidTuneInfo::COMPATIBILITY_C64:
             if (flags & PSID_SPECIFIC)
-                info->m_compatibility = SidTuneInfo::COMPATIBILITY_PSID;
+                hdr.m_compatibility = SidTuneInfo::COMPATIBILITY_PSID;
             break;
         case SidTuneInfo::COMPATIBILITY_R64:
             if (flags & PSID_BASIC)
-                info->m_compatibility = SidTuneInfo::COMPATIBILITY_BASIC;
+                hdr.m_compatibility = SidTuneInfo::COMPATIBILITY_BASIC;
             break;
         default:
             break;
         }
 
-        info->m_clockSpeed = clock;
+        hdr.m_sidModels[0] = getSidModel(flags >> 4);
 
-        info->m_sidModels[0] = getSidModel(flags >> 4);
+        hdr.m_relocStartPage = data[120];
+        hdr.m_relocPages     = data[121];
 
-        info->m_relocStartPage = pHeader.relocStartPage;
-        info->m_relocPages     = pHeader.relocPages;
-
-        if (pHeader.version >= 3)
+        if (version >= 3)
         {
-            if (validateAddress(pHeader.sidChipBase2))
-            {
-                info->m_sidChipAddresses.push_back(0xd000 | (pHeader.sidChipBase2 << 4));
+            const uint_least8_t sidChipBase2 = data[122];
 
-                info->m_sidModels.push_back(getSidModel(flags >> 6));
+            if (validateAddress(sidChipBase2))
+            {
+                hdr.m_sidChipAddresses[hdr.m_sidChips] = 0xd000 | (sidChipBase2 << 4);
+                hdr.m_sidModels[hdr.m_sidChips] = getSidModel(flags >> 6);
+                hdr.m_sidChips++;
             }
 
-            if (pHeader.version >= 4)
+            if (version >= 4)
             {
-                if (pHeader.sidChipBase3 != pHeader.sidChipBase2
-                    && validateAddress(pHeader.sidChipBase3))
-                {
-                    info->m_sidChipAddresses.push_back(0xd000 | (pHeader.sidChipBase3 << 4));
+                const uint_least8_t sidChipBase3 = data[123];
 
-                    info->m_sidModels.push_back(getSidModel(flags >> 8));
+                if (sidChipBase3 != sidChipBase2
+                    && validateAddress(sidChipBase3))
+                {
+                    hdr.m_sidChipAddresses[hdr.m_sidChips] = 0xd000 | (sidChipBase3 << 4);
+                    hdr.m_sidModels[hdr.m_sidChips] = getSidModel(flags >> 8);
+                    hdr.m_sidChips++;
                 }
             }
         }
@@ -335,26 +328,62 @@ void PSID::tryLoad(const psidHeader &pHeader)
     // as required by the RSID specification
     if (compatibility == SidTuneInfo::COMPATIBILITY_R64)
     {
-        if ((info->m_loadAddr != 0)
-            || (info->m_playAddr != 0)
+        if ((hdr.m_loadAddr != 0)
+            || (hdr.m_playAddr != 0)
             || (speed != 0))
         {
-            throw loadError(ERR_INVALID);
+            return ERR_INVALID;
         }
 
         // Real C64 tunes appear as CIA
         speed = ~0;
     }
 
+    hdr.m_speed      = speed;
+    hdr.m_clockSpeed = clock;
+
+    // Copy info strings, making sure they are terminated.
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        memcpy(hdr.m_infoString[i], &data[22 + i * PSID_MAXSTRLEN], PSID_MAXSTRLEN);
+        hdr.m_infoString[i][PSID_MAXSTRLEN] = '\0';
+    }
+
+    return nullptr;
+}
+
+void PSID::tryLoad(const SidTuneHeader &header)
+{
+    info->m_formatString   = header.formatString();
+    fileOffset             = header.dataOffset();
+    info->m_loadAddr       = header.loadAddr();
+    info->m_initAddr       = header.initAddr();
+    info->m_playAddr       = header.playAddr();
+    info->m_songs          = header.songs();
+    info->m_startSong      = header.startSong();
+    info->m_compatibility  = header.compatibility();
+    info->m_relocStartPage = header.relocStartPage();
+    info->m_relocPages     = header.relocPages();
+    info->m_clockSpeed     = header.clockSpeed();
+
+    info->m_sidModels[0] = header.sidModel(0);
+
+    for (unsigned int i = 1; i < header.sidChips(); i++)
+    {
+        info->m_sidChipAddresses.push_back(header.sidChipBase(i));
+        info->m_sidModels.push_back(header.sidModel(i));
+    }
+
     // Create the speed/clock setting table.
-    convertOldStyleSpeedToTables(speed, clock);
+    convertOldStyleSpeedToTables(header.m_speed, header.clockSpeed());
 
     // Copy info strings.
-    info->m_infoString.push_back(std::string(pHeader.name, PSID_MAXSTRLEN));
-    info->m_infoString.push_back(std::string(pHeader.author, PSID_MAXSTRLEN));
-    info->m_infoString.push_back(std::string(pHeader.released, PSID_MAXSTRLEN));
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        info->m_infoString.push_back(std::string(header.infoString(i)));
+    }
 
-    if (musPlayer)
+    if (header.isMus())
         throw loadError("Compute!'s Sidplayer MUS data is not supported yet"); // TODO
 }
 
@@ -369,7 +398,7 @@ const char *PSID::createMD5(char *md5)
     {
         // Include C64 data.
         sidmd5 myMD5;
-        myMD5.append(&cache[fileOffset], info->m_c64dataLen);
+        myMD5.append(fileData + fileOffset, info->m_c64dataLen);
 
         uint8_t tmp[2];
         // Include INIT and PLAY address.
@@ -440,7 +469,7 @@ const char *PSID::createMD5New(char *md5)
         // The calculation is now simplified
         // All the header + all the data
         sidmd5 myMD5;
-        myMD5.append(&cache[0], cache.size());
+        myMD5.append(fileData, info->m_dataFileLen);
 
         myMD5.finish();
 
@@ -26,14 +26,13 @@
 #include "SidTuneBase.h"
 
 #include "sidplayfp/SidTune.h"
+#include "sidplayfp/SidTuneHeader.h"
 
 #include "sidcxx11.h"
 
 namespace libsidplayfp
 {
 
-struct psidHeader;
-
 class PSID final : public SidTuneBase
 {
 private:
@@ -45,14 +44,7 @@ private:
      *
      * @throw loadError
      */
-    void tryLoad(const psidHeader &pHeader);
-
-    /**
-     * Read PSID file header.
-     *
-     * @throw loadError
-     */
-    static void readHeader(const buffer_t &dataBuf, psidHeader &hdr);
+    void tryLoad(const SidTuneHeader &header);
 
 protected:
     PSID() {}
@@ -66,6 +58,27 @@ public:
      */
     static SidTuneBase* load(buffer_t& dataBuf);
 
+    /**
+     * @return pointer to a SidTune
+     * @throw loadError if PSID file is corrupt
+     */
+    static SidTuneBase* load(const uint_least8_t* data, uint_least32_t size);
+
+    /**
+     * Check the magic ID, data must be at least 4 bytes long.
+     */
+    static bool isPSID(const uint_least8_t* data);
+
+    /**
+     * Validate and decode a PSID file header in place.
+     *
+     * @param data the file contents
+     * @param size size of the data
+     * @param header the decoded header
+     * @return nullptr on success, the error message if the header is not valid
+     */
+    static const char* readHeader(const uint_least8_t* data, uint_least32_t size, SidTuneHeader &header);
+
     virtual const char *createMD5(char *md5) override;
 
     virtual const char *createMD5New(char *md5) override;
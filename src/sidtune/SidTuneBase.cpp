@@ -42,6 +42,8 @@
 #include "prg.h"
 #include "PSID.h"
 
+#include "sidplayfp/SidTuneArchive.h"
+
 namespace libsidplayfp
 {
 
@@ -119,6 +121,14 @@ SidTuneBase* SidTuneBase::read(const uint_least8_t* sourceBuffer, uint_least32_t
     return getFromBuffer(sourceBuffer, bufferLen);
 }
 
+SidTuneBase* SidTuneBase::load(const SidTuneArchive& archive, const char* fileName, const char **fileNameExt)
+{
+    if (fileName == nullptr)
+        return nullptr;
+
+    return getFromArchive(archive, fileName, fileNameExt);
+}
+
 const SidTuneInfo* SidTuneBase::getInfo() const
 {
     return info.get();
@@ -178,7 +188,7 @@ void SidTuneBase::placeSidTuneInC64mem(sidmemory& mem)
     mem.writeMemWord(0xae, end);
 
     // Copy data from cache to the correct destination.
-    mem.fillRam(info->m_loadAddr, &cache[fileOffset], info->m_c64dataLen);
+    mem.fillRam(info->m_loadAddr, fileData + fileOffset, info->m_c64dataLen);
 }
 
 void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
@@ -224,7 +234,8 @@ void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
 
 SidTuneBase::SidTuneBase() :
     info(new SidTuneInfoImpl()),
-    fileOffset(0)
+    fileOffset(0),
+    fileData(nullptr)
 {
     // Initialize the object with some safe defaults.
     for (unsigned int si = 0; si < MAX_SONGS; si++)
@@ -278,6 +289,15 @@ SidTuneBase* SidTuneBase::getFromBuffer(const uint_least8_t* const buffer, uint_
 
 void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileName,
                             buffer_t& buf, bool isSlashedFileName)
+{
+    acceptSidTuneData(dataFileName, infoFileName, &buf[0], buf.size(), isSlashedFileName);
+
+    cache.swap(buf);
+    fileData = &cache[0];
+}
+
+void SidTuneBase::acceptSidTuneData(const char* dataFileName, const char* infoFileName,
+                            const uint_least8_t* buf, uint_least32_t bufLen, bool isSlashedFileName)
 {
     // Make a copy of the data file name and path, if available.
     if (dataFileName != nullptr)
@@ -314,8 +334,8 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         info->m_startSong = 1;
     }
 
-    info->m_dataFileLen = buf.size();
-    info->m_c64dataLen = buf.size() - fileOffset;
+    info->m_dataFileLen = bufLen;
+    info->m_c64dataLen = bufLen - fileOffset;
 
     // Calculate any remaining addresses and then
     // confirm all the file details are correct
@@ -347,8 +367,6 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
     {
         throw loadError(ERR_EMPTY);
     }
-
-    cache.swap(buf);
 }
 
 void SidTuneBase::createNewFileName(std::string& destString,
@@ -369,11 +387,80 @@ SidTuneBase* SidTuneBase::getFromFiles(const char* fileName, const char **fileNa
 
 SidTuneBase* SidTuneBase::getFromFiles(LoaderFunc loader, const char* fileName, const char **fileNameExtensions, bool separatorIsSlash)
 {
-    buffer_t fileBuf1;
-
     if (loader == nullptr)
         loader = (LoaderFunc) loadFile;
 
+    return getFromLoader(loader, fileName, fileNameExtensions, separatorIsSlash);
+}
+
+/**
+ * Loader for files in an archive, companion files
+ * are resolved with an index lookup.
+ */
+class archiveLoader
+{
+private:
+    const SidTuneArchive &archive;
+
+public:
+    archiveLoader(const SidTuneArchive &archive) : archive(archive) {}
+
+    void operator()(const char* fileName, std::vector<uint8_t>& bufferRef) const
+    {
+        uint_least32_t length;
+        const uint_least8_t* data = archive.find(fileName, length);
+        if (data == nullptr)
+        {
+            throw loadError(ERR_CANT_OPEN_FILE);
+        }
+
+        if (length == 0)
+        {
+            throw loadError(ERR_EMPTY);
+        }
+
+        bufferRef.assign(data, data + length);
+    }
+};
+
+SidTuneBase* SidTuneBase::readInPlace(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen, const char* fileName)
+{
+    if ((bufferLen < 4) || !PSID::isPSID(sourceBuffer))
+        return nullptr;
+
+    if (bufferLen > MAX_FILELEN)
+    {
+        throw loadError(ERR_FILE_TOO_LONG);
+    }
+
+    std::unique_ptr<SidTuneBase> s(PSID::load(sourceBuffer, bufferLen));
+    s->acceptSidTuneData(fileName, nullptr, sourceBuffer, bufferLen, true);
+    s->fileData = sourceBuffer;
+    return s.release();
+}
+
+SidTuneBase* SidTuneBase::getFromArchive(const SidTuneArchive& archive, const char* fileName, const char **fileNameExtensions)
+{
+    uint_least32_t length;
+    const uint_least8_t* data = archive.find(fileName, length);
+    if (data == nullptr)
+    {
+        throw loadError(ERR_CANT_OPEN_FILE);
+    }
+
+    // PSID tunes are used in place, the archive owns the data.
+    SidTuneBase* s = readInPlace(data, length, fileName);
+    if (s != nullptr)
+        return s;
+
+    return getFromLoader(archiveLoader(archive), fileName, fileNameExtensions, true);
+}
+
+template<class Loader>
+SidTuneBase* SidTuneBase::getFromLoader(Loader loader, const char* fileName, const char **fileNameExtensions, bool separatorIsSlash)
+{
+    buffer_t fileBuf1;
+
     loader(fileName, fileBuf1);
 
     // File loaded. Now check if it is in a valid single-file-format.
@@ -36,6 +36,8 @@
 
 #include "sidcxx11.h"
 
+class SidTuneArchive;
+
 namespace libsidplayfp
 {
 
@@ -120,6 +122,33 @@ public:  // ----------------------------------------------------------------
      */
     static SidTuneBase* read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
 
+    /**
+     * Load a PSID/RSID tune referencing the buffer directly.
+     * The buffer must outlive the returned tune.
+     *
+     * @param sourceBuffer
+     * @param bufferLen
+     * @param fileName optional tune path, using '/' as separator
+     * @return the sid tune, nullptr if the data is not in PSID format
+     * @throw loadError
+     */
+    static SidTuneBase* readInPlace(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen, const char* fileName = nullptr);
+
+    /**
+     * Load a sidtune from an archive.
+     *
+     * PSID tunes reference the archive data directly,
+     * other formats are copied. Companion files of MUS/STR
+     * pairs are looked up in the archive index.
+     *
+     * @param archive the open archive
+     * @param fileName path of the tune in the archive
+     * @param fileNameExt
+     * @return the sid tune
+     * @throw loadError
+     */
+    static SidTuneBase* load(const SidTuneArchive& archive, const char* fileName, const char **fileNameExt);
+
     /**
      * Select sub-song (0 = default starting song)
      * and return active song number out of [1,2,..,SIDTUNE_MAX_SONGS].
@@ -170,7 +199,7 @@ public:  // ----------------------------------------------------------------
     /**
      * Get the pointer to the tune data.
      */
-    const uint_least8_t* c64Data() const { return &cache[fileOffset]; }
+    const uint_least8_t* c64Data() const { return fileData + fileOffset; }
 
 protected:  // -------------------------------------------------------------
 
@@ -182,8 +211,12 @@ protected:  // -------------------------------------------------------------
     /// For files with header: offset to real data
     uint_least32_t fileOffset;
 
+    /// Owned copy of the file, empty if the data is borrowed
     buffer_t cache;
 
+    /// The file contents, points either to cache or to borrowed data
+    const uint_least8_t* fileData;
+
 protected:
     SidTuneBase();
 
@@ -243,6 +276,15 @@ protected:
     virtual void acceptSidTune(const char* dataFileName, const char* infoFileName,
                         buffer_t& buf, bool isSlashedFileName);
 
+    /**
+     * Validate a sidtune and set up its file names,
+     * without taking ownership of the data.
+     *
+     * @throw loadError
+     */
+    void acceptSidTuneData(const char* dataFileName, const char* infoFileName,
+                        const uint_least8_t* buf, uint_least32_t bufLen, bool isSlashedFileName);
+
     /**
      * Petscii to Ascii converter.
      */
@@ -256,6 +298,11 @@ private:  // ---------------------------------------------------------------
     static SidTuneBase* getFromFiles(const char* name, const char **fileNameExtensions, bool separatorIsSlash);
     static SidTuneBase* getFromFiles(LoaderFunc loader, const char* name, const char **fileNameExtensions, bool separatorIsSlash);
 
+    template<class Loader>
+    static SidTuneBase* getFromLoader(Loader loader, const char* name, const char **fileNameExtensions, bool separatorIsSlash);
+
+    static SidTuneBase* getFromArchive(const SidTuneArchive& archive, const char* name, const char **fileNameExtensions);
+
     /**
      * Try to retrieve single-file sidtune from specified buffer.
      */
@@ -0,0 +1,336 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "tarIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+const char ERR_CANT_OPEN[]   = "Could not open archive";
+const char ERR_NOT_TAR[]     = "Not a tar archive";
+const char ERR_TRUNCATED[]   = "Archive is truncated";
+
+const size_t BLOCK_SIZE = 512;
+
+// ustar header fields
+const size_t TAR_NAME      = 0;
+const size_t TAR_SIZE      = 124;
+const size_t TAR_CHKSUM    = 148;
+const size_t TAR_TYPEFLAG  = 156;
+const size_t TAR_MAGIC     = 257;
+const size_t TAR_PREFIX    = 345;
+
+/**
+ * Parse a zero or space terminated octal field.
+ */
+uint64_t parseOctal(const uint8_t* field, size_t len)
+{
+    uint64_t value = 0;
+    size_t i = 0;
+
+    while ((i < len) && (field[i] == ' '))
+        i++;
+
+    for (; (i < len) && (field[i] >= '0') && (field[i] <= '7'); i++)
+    {
+        value = (value << 3) | (field[i] - '0');
+    }
+
+    return value;
+}
+
+/**
+ * Parse the size field, either octal or GNU base-256.
+ */
+uint64_t parseSize(const uint8_t* header)
+{
+    const uint8_t* field = header + TAR_SIZE;
+
+    if (field[0] & 0x80)
+    {
+        uint64_t value = 0;
+        for (size_t i = 1; i < 12; i++)
+        {
+            value = (value << 8) | field[i];
+        }
+        return value;
+    }
+
+    return parseOctal(field, 12);
+}
+
+/**
+ * Verify the header checksum, computed with the checksum field
+ * filled with spaces. Some old archivers used signed chars.
+ */
+bool checksumOk(const uint8_t* header)
+{
+    const uint64_t stored = parseOctal(header + TAR_CHKSUM, 8);
+
+    unsigned int sum = 0;
+    int signedSum = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i++)
+    {
+        const uint8_t c = ((i >= TAR_CHKSUM) && (i < TAR_CHKSUM + 8)) ? ' ' : header[i];
+        sum += c;
+        signedSum += static_cast<signed char>(c);
+    }
+
+    return (stored == sum) || (stored == static_cast<uint64_t>(signedSum));
+}
+
+/**
+ * Length of a field which is not necessarily zero terminated.
+ */
+size_t fieldLength(const uint8_t* field, size_t maxLen)
+{
+    const void* end = memchr(field, 0, maxLen);
+    return end ? static_cast<const uint8_t*>(end) - field : maxLen;
+}
+
+/**
+ * Strip leading "./" and "/".
+ */
+const char* normalize(const char* path)
+{
+    for (;;)
+    {
+        if (path[0] == '/')
+            path++;
+        else if ((path[0] == '.') && (path[1] == '/'))
+            path += 2;
+        else
+            return path;
+    }
+}
+
+/**
+ * Extract the "path" record from a pax extended header.
+ * Records have the form "<length> <key>=<value>\n"
+ * where length is decimal and includes the whole record.
+ */
+bool paxPath(const uint8_t* data, size_t len, std::string& path)
+{
+    size_t pos = 0;
+    while (pos < len)
+    {
+        size_t i = pos;
+        size_t recordLen = 0;
+        while ((i < len) && (data[i] >= '0') && (data[i] <= '9'))
+        {
+            recordLen = recordLen * 10 + (data[i] - '0');
+            i++;
+        }
+
+        if ((i >= len) || (data[i] != ' ')
+            || (recordLen <= i + 1 - pos) || (recordLen > len - pos))
+            return false;
+
+        const char* key = reinterpret_cast<const char*>(data + i + 1);
+        // Exclude the trailing newline
+        const size_t keyLen = pos + recordLen - (i + 1) - 1;
+        if ((keyLen > 5) && (strncmp(key, "path=", 5) == 0))
+        {
+            path.assign(key + 5, keyLen - 5);
+            return true;
+        }
+
+        pos += recordLen;
+    }
+
+    return false;
+}
+
+/**
+ * Compare an entry with a lookup path.
+ */
+struct pathLess
+{
+    template<typename T>
+    bool operator()(const T& e, const char* path) const { return e.path.compare(path) < 0; }
+};
+
+bool tarIndex::open(const char* fileName)
+{
+    close();
+
+    if (!m_file.open(fileName))
+    {
+        m_error = ERR_CANT_OPEN;
+        return false;
+    }
+
+    if (!scan())
+    {
+        close();
+        return false;
+    }
+
+    m_error = nullptr;
+    return true;
+}
+
+void tarIndex::close()
+{
+    entries_t().swap(m_entries);
+    m_file.close();
+}
+
+bool tarIndex::scan()
+{
+    const uint8_t* base = m_file.data();
+    const size_t size = m_file.size();
+
+    std::string longName;
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        if (size - pos < BLOCK_SIZE)
+        {
+            m_error = ERR_TRUNCATED;
+            return false;
+        }
+
+        const uint8_t* header = base + pos;
+
+        // A zero block marks the end of the archive
+        if (header[0] == 0)
+            break;
+
+        if (!checksumOk(header))
+        {
+            m_error = ERR_NOT_TAR;
+            return false;
+        }
+
+        const uint64_t fileSize = parseSize(header);
+        const size_t dataPos = pos + BLOCK_SIZE;
+
+        if (fileSize > size - dataPos)
+        {
+            m_error = ERR_TRUNCATED;
+            return false;
+        }
+
+        const uint8_t* data = base + dataPos;
+        const size_t dataLen = static_cast<size_t>(fileSize);
+
+        switch (header[TAR_TYPEFLAG])
+        {
+        case 'L':
+            // GNU long name for the next entry
+            longName.assign(reinterpret_cast<const char*>(data), fieldLength(data, dataLen));
+            break;
+        case 'x':
+            // pax extended header for the next entry
+            if (!paxPath(data, dataLen, longName))
+                longName.clear();
+            break;
+        case '0':
+        case '\0':
+        case '7':
+        {
+            entry_t e;
+            if (!longName.empty())
+            {
+                e.path.assign(normalize(longName.c_str()));
+                longName.clear();
+            }
+            else
+            {
+                const char* name = reinterpret_cast<const char*>(header + TAR_NAME);
+                const char* prefix = reinterpret_cast<const char*>(header + TAR_PREFIX);
+                if ((memcmp(header + TAR_MAGIC, "ustar", 5) == 0) && (prefix[0] != '\0'))
+                {
+                    e.path.assign(prefix, fieldLength(header + TAR_PREFIX, 155));
+                    e.path.push_back('/');
+                }
+                e.path.append(name, fieldLength(header + TAR_NAME, 100));
+                e.path.assign(normalize(e.path.c_str()));
+            }
+
+            // Sidtunes are tiny, skip anything which can't be addressed
+            if (fileSize <= 0xffffffff)
+            {
+                e.offset = dataPos;
+                e.length = static_cast<uint_least32_t>(fileSize);
+                m_entries.push_back(e);
+            }
+            break;
+        }
+        default:
+            // Directories, links and other special entries
+            longName.clear();
+            break;
+        }
+
+        pos = dataPos + ((dataLen + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1));
+    }
+
+    // Sort for binary search. When a path appears more than once
+    // the last copy in the archive wins, as with tar extraction.
+    std::stable_sort(m_entries.begin(), m_entries.end());
+
+    entries_t::iterator out = m_entries.begin();
+    for (entries_t::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        entries_t::iterator next = it + 1;
+        if ((next != m_entries.end()) && (next->path == it->path))
+            continue;
+
+        if (out != it)
+        {
+            out->path.swap(it->path);
+            out->offset = it->offset;
+            out->length = it->length;
+        }
+        ++out;
+    }
+    m_entries.erase(out, m_entries.end());
+
+    return true;
+}
+
+const tarIndex::entry_t* tarIndex::findEntry(const char* path) const
+{
+    path = normalize(path);
+
+    entries_t::const_iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), path, pathLess());
+    if ((it == m_entries.end()) || (it->path.compare(path) != 0))
+        return nullptr;
+
+    return &(*it);
+}
+
+const uint8_t* tarIndex::find(const char* path, uint_least32_t& length) const
+{
+    const entry_t* e = findEntry(path);
+    if (e == nullptr)
+        return nullptr;
+
+    length = e->length;
+    return m_file.data() + e->offset;
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TARINDEX_H
+#define TARINDEX_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "utils/mappedFile.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Random access index over an uncompressed tar archive.
+ *
+ * The archive is mapped in memory and its headers are scanned once
+ * to build a sorted path to (offset, length) table.
+ * Entry data is returned as pointers into the mapping.
+ * Plain ustar, GNU long names and pax path records are supported.
+ */
+class tarIndex
+{
+private:
+    struct entry_t
+    {
+        std::string path;
+        size_t offset;
+        uint_least32_t length;
+
+        bool operator<(const entry_t& other) const { return path < other.path; }
+    };
+
+    typedef std::vector<entry_t> entries_t;
+
+private:
+    mappedFile m_file;
+
+    entries_t m_entries;
+
+    const char* m_error;
+
+private:
+    bool scan();
+
+    const entry_t* findEntry(const char* path) const;
+
+public:
+    tarIndex() : m_error(nullptr) {}
+
+    /**
+     * Open an archive and build the index.
+     *
+     * @return false on error
+     */
+    bool open(const char* fileName);
+
+    void close();
+
+    const char* error() const { return m_error; }
+
+    unsigned int entries() const { return m_entries.size(); }
+
+    const char* path(unsigned int i) const { return m_entries[i].path.c_str(); }
+
+    const uint8_t* data(unsigned int i, uint_least32_t& length) const
+    {
+        length = m_entries[i].length;
+        return m_file.data() + m_entries[i].offset;
+    }
+
+    /**
+     * Look up an entry.
+     * Leading "./" and "/" are ignored.
+     *
+     * @param path the entry path, using '/' as separator
+     * @param length the entry length
+     * @return pointer to the entry data, 0 if not found
+     */
+    const uint8_t* find(const char* path, uint_least32_t& length) const;
+};
+
+}
+
+#endif // TARINDEX_H
@@ -37,6 +37,7 @@
 #include <fstream>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include "stringutils.h"
 
@@ -48,6 +49,32 @@ const float VERSION_NO = 3.0f;
 
 #define CERR_STIL_DEBUG if (STIL_DEBUG) cerr << "Line #" << __LINE__ << " STIL::"
 
+/**
+ * Read a whole file in a single block.
+ *
+ * @return false if the file cannot be opened or read
+ */
+static bool readFile(const string &name, vector<char> &buffer)
+{
+    ifstream file(name.c_str(), STILopenFlags);
+
+    if (file.fail())
+        return false;
+
+    file.seekg(0, ios::end);
+    const streamoff size = file.tellg();
+    if (size < 0)
+        return false;
+
+    buffer.resize(static_cast<size_t>(size));
+    file.seekg(0, ios::beg);
+
+    if (size > 0)
+        file.read(&buffer[0], size);
+
+    return !file.fail();
+}
+
 // These are the hardcoded STIL/BUG field names.
 const char    _NAME_STR[] = "   NAME: ";
 const char  _AUTHOR_STR[] = " AUTHOR: ";
@@ -169,48 +196,58 @@ STIL::setBaseDir(const char *pathToHVSC)
         tempBaseDir.erase(lastChar);
     }
 
-    // Attempt to open STIL
+    // Create the full paths+filenames
+    string stilName = tempBaseDir;
+    stilName.append(PATH_TO_STIL);
+    convertSlashes(stilName);
 
-    // Create the full path+filename
-    string tempName = tempBaseDir;
-    tempName.append(PATH_TO_STIL);
-    convertSlashes(tempName);
+    string bugName = tempBaseDir;
+    bugName.append(PATH_TO_BUGLIST);
+    convertSlashes(bugName);
 
-    ifstream stilFile(tempName.c_str(), STILopenFlags);
+    // Read both files at once, STIL.txt is several MB
+    vector<char> stilData;
+    vector<char> bugData;
+    bool stilRead;
+    bool bugRead;
 
-    if (stilFile.fail())
+    #pragma omp parallel sections
     {
-        CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
+        #pragma omp section
+        stilRead = readFile(stilName, stilData);
+
+        #pragma omp section
+        bugRead = readFile(bugName, bugData);
+    }
+
+    // Attempt to open STIL
+
+    if (!stilRead)
+    {
+        CERR_STIL_DEBUG << "setBaseDir() open failed for " << stilName << endl;
         lastError = STIL_OPEN;
         return false;
     }
 
-    CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
+    CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << stilName << endl;
 
     // Attempt to open BUGlist
 
-    // Create the full path+filename
-    tempName = tempBaseDir;
-    tempName.append(PATH_TO_BUGLIST);
-    convertSlashes(tempName);
-
-    ifstream bugFile(tempName.c_str(), STILopenFlags);
-
-    if (bugFile.fail())
+    if (!bugRead)
     {
         // This is not a critical error - some earlier versions of HVSC did
         // not have a BUGlist.txt file at all.
 
-        CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
+        CERR_STIL_DEBUG << "setBaseDir() open failed for " << bugName << endl;
         lastError = BUG_OPEN;
     }
     else
     {
-        CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
+        CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << bugName << endl;
     }
 
     // Find out what the EOL really is
-    if (determineEOL(stilFile) != true)
+    if (determineEOL(stilData.empty() ? 0 : &stilData[0], stilData.size()) != true)
     {
         CERR_STIL_DEBUG << "determinEOL() failed" << endl;
         lastError = NO_EOL;
@@ -227,8 +264,24 @@ STIL::setBaseDir(const char *pathToHVSC)
     STILVersion = 0.0;
 
     // These will populate the tempStilDirs and tempBugDirs maps (or not :)
+    // The BUGlist pass only reads the EOL so both can run at once.
+
+    bool stilDirsFound = false;
+    bool bugDirsFound = true;
+
+    #pragma omp parallel sections
+    {
+        #pragma omp section
+        stilDirsFound = getDirs(&stilData[0], stilData.size(), tempStilDirs, true);
+
+        #pragma omp section
+        if (bugRead)
+        {
+            bugDirsFound = getDirs(bugData.empty() ? 0 : &bugData[0], bugData.size(), tempBugDirs, false);
+        }
+    }
 
-    if (getDirs(stilFile, tempStilDirs, true) != true)
+    if (stilDirsFound != true)
     {
         CERR_STIL_DEBUG << "getDirs() failed for stilFile" << endl;
         lastError = NO_STIL_DIRS;
@@ -239,17 +292,14 @@ STIL::setBaseDir(const char *pathToHVSC)
         return false;
     }
 
-    if (bugFile.good())
+    if (bugDirsFound != true)
     {
-        if (getDirs(bugFile, tempBugDirs, false) != true)
-        {
-            // This is not a critical error - it is possible that the
-            // BUGlist.txt file has no entries in it at all (in fact, that's
-            // good!).
+        // This is not a critical error - it is possible that the
+        // BUGlist.txt file has no entries in it at all (in fact, that's
+        // good!).
 
-            CERR_STIL_DEBUG << "getDirs() failed for bugFile" << endl;
-            lastError = BUG_OPEN;
-        }
+        CERR_STIL_DEBUG << "getDirs() failed for bugFile" << endl;
+        lastError = BUG_OPEN;
     }
 
     // Now we can copy the stuff into private data.
@@ -592,44 +642,28 @@ STIL::getGlobalComment(const char *relPathToEntry)
 //////// PRIVATE
 
 bool
-STIL::determineEOL(ifstream &stilFile)
+STIL::determineEOL(const char *data, size_t size)
 {
     CERR_STIL_DEBUG << "detEOL() called" << endl;
 
-    if (stilFile.fail())
-    {
-        CERR_STIL_DEBUG << "detEOL() open failed" << endl;
-        return false;
-    }
-
-    stilFile.seekg(0);
-
     STIL_EOL = '\0';
     STIL_EOL2 = '\0';
 
     // Determine what the EOL character is
     // (it can be different from OS to OS).
-    istream::sentry se(stilFile, true);
-    if (se)
+    for (size_t i = 0; i < size; i++)
     {
-        streambuf *sb = stilFile.rdbuf();
-
-        const int eof = char_traits<char>::eof();
-
-        while (sb->sgetc() != eof)
+        const char c = data[i];
+        if ((c == '\n') || (c == '\r'))
         {
-            const int c = sb->sbumpc();
-            if ((c == '\n') || (c == '\r'))
-            {
-                STIL_EOL = c;
+            STIL_EOL = c;
 
-                if (c == '\r')
-                {
-                    if (sb->sgetc() == '\n')
-                        STIL_EOL2 = '\n';
-                }
-                break;
+            if (c == '\r')
+            {
+                if ((i + 1 < size) && (data[i + 1] == '\n'))
+                    STIL_EOL2 = '\n';
             }
+            break;
         }
     }
 
@@ -646,30 +680,51 @@ STIL::determineEOL(ifstream &stilFile)
 }
 
 bool
-STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
+STIL::getDirs(const char *data, size_t size, dirList &dirs, bool isSTILFile)
 {
     bool newDir = !isSTILFile;
 
     CERR_STIL_DEBUG << "getDirs() called" << endl;
 
-    inFile.seekg(0);
+    // Lines are split as getStilLine() does
+    size_t pos = 0;
+    bool more = true;
 
-    while (inFile.good())
+    while (more)
     {
-        string line;
+        // If there was a remaining EOL char from the previous line, eat it up.
+        if ((STIL_EOL2 != '\0') && (pos < size) && ((data[pos] == 0x0d) || (data[pos] == 0x0a)))
+        {
+            pos++;
+        }
 
-        getStilLine(inFile, line);
+        const char *line = data + pos;
+        const char *eol = (pos < size) ? static_cast<const char*>(memchr(line, STIL_EOL, size - pos)) : 0;
 
-        if (!isSTILFile) { CERR_STIL_DEBUG << line << '\n'; }
+        size_t length;
+        size_t next;
+        if (eol != 0)
+        {
+            length = eol - line;
+            next = pos + length + 1;
+        }
+        else
+        {
+            length = size - pos;
+            next = size;
+            more = false;
+        }
+
+        if (!isSTILFile) { CERR_STIL_DEBUG << string(line, length) << '\n'; }
 
         // Try to extract STIL's version number if it's not done, yet.
 
         if (isSTILFile && (STILVersion == 0.0f))
         {
-            if (strncmp(line.data(), "#  STIL v", 9) == 0)
+            if ((length >= 9) && (strncmp(line, "#  STIL v", 9) == 0))
             {
                 // Get the version number
-                STILVersion = atof(line.c_str() + 9);
+                STILVersion = atof(string(line + 9, length - 9).c_str());
 
                 // Put it into the string, too.
                 ostringstream ss;
@@ -679,24 +734,29 @@ STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
 
                 CERR_STIL_DEBUG << "getDirs() STILVersion=" << STILVersion << endl;
 
+                pos = next;
                 continue;
             }
         }
 
         // Search for the start of a dir separator first.
 
-        if (isSTILFile && !newDir && stringutils::equal(line.data(), "### ", 4))
+        if (isSTILFile && !newDir && (length >= 4) && stringutils::equal(line, "### ", 4))
         {
             newDir = true;
+            pos = next;
             continue;
         }
 
         // Is this the start of an entry immediately following a dir separator?
 
-        if (newDir && (line[0] == '/'))
+        if (newDir && (length > 0) && (line[0] == '/'))
         {
             // Get the directory only
-            const string dirName(line, 0, line.find_last_of('/') + 1);
+            size_t slash = length - 1;
+            while (line[slash] != '/')
+                slash--;
+            const string dirName(line, slash + 1);
 
             if (!isSTILFile)
             {
@@ -707,7 +767,7 @@ STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
             // Store the info
             if (newDir)
             {
-                const streampos position = inFile.tellg() - (streampos)line.size() - 1L;
+                const streampos position = static_cast<streamoff>(pos);
 
                 CERR_STIL_DEBUG << "getDirs() dirName=" << dirName << ", pos=" << position <<  endl;
 
@@ -716,6 +776,8 @@ STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
 
             newDir = !isSTILFile;
         }
+
+        pos = next;
     }
 
     if (dirs.empty())
@@ -327,27 +327,32 @@ private:
      * Determines what the EOL char is (or are) from STIL.txt.
      * It is assumed that BUGlist.txt will use the same EOL.
      *
+     * @param data - the content of STIL.txt
+     * @param size - the size of the content
      * @return
      *      - false - something went wrong
      *      - true  - everything is okay
      */
-    bool determineEOL(std::ifstream &stilFile);
+    bool determineEOL(const char *data, size_t size);
 
     /**
      * Populates the given dirList array with the directories
-     * obtained from 'inFile' for faster positioning within
-     * 'inFile'.
+     * obtained from the content of a file for faster positioning
+     * within the file.
+     * Does not touch the object state when parsing the BUGlist,
+     * so that both files can be indexed at the same time.
      *
-     * @param inFile - where to read the directories from
+     * @param data - the content of the file
+     * @param size - the size of the content
      * @param dirs   - the dirList array that should be populated with the
      *                 directory list
      * @param isSTILFile - is this the STIL or the BUGlist we are parsing
      * @return
      *      - false - No entries were found or otherwise failed to process
-     *                inFile
+     *                the file
      *      - true  - everything is okay
      */
-    bool getDirs(std::ifstream &inFile, dirList &dirs, bool isSTILFile);
+    bool getDirs(const char *data, size_t size, dirList &dirs, bool isSTILFile);
 
     /**
      * Positions the file pointer to the given entry in 'inFile'
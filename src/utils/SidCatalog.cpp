@@ -0,0 +1,599 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidCatalog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "SidDatabase.h"
+#include "mappedFile.h"
+
+#include "sidplayfp/SidTune.h"
+#include "sidplayfp/SidTuneInfo.h"
+#include "sidtune/SidTuneBase.h"
+
+#include "sidendian.h"
+#include "sidcxx11.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <dirent.h>
+#  include <sys/stat.h>
+#endif
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+/*
+ * Index file layout, all values are little endian.
+ *
+ * Header (24 bytes)
+ *  +00  "SIDX"
+ *  +04  version (16 bit)
+ *  +06  reserved (16 bit)
+ *  +08  number of tunes (32 bit)
+ *  +0C  number of files (32 bit)
+ *  +10  number of song lengths (32 bit)
+ *  +14  size of the string table (32 bit)
+ *
+ * Tune records (52 bytes each), one per distinct file content
+ *  +00  MD5 (16 bytes, old format)
+ *  +10  MD5 (16 bytes, new format)
+ *  +20  load address (16 bit)
+ *  +22  init address (16 bit)
+ *  +24  play address (16 bit)
+ *  +26  number of songs (16 bit)
+ *  +28  start song (16 bit)
+ *  +2A  clock (bits 0-1) and compatibility (bits 2-3)
+ *  +2B  SID models, two bits per chip
+ *  +2C  second SID address middle byte, 0 if not used
+ *  +2D  third SID address middle byte, 0 if not used
+ *  +2E  reserved (16 bit)
+ *  +30  index of the first song length, 0xffffffff if not found (32 bit)
+ *
+ * File records (12 bytes each), sorted by path
+ *  +00  path offset in the string table (32 bit)
+ *  +04  tune record index (32 bit)
+ *  +08  flags: bit 0 STIL entry, bit 1 BUGlist entry
+ *  +09  reserved (3 bytes)
+ *
+ * Song lengths in milliseconds (32 bit each)
+ *
+ * String table
+ *  Zero terminated paths relative to the collection root,
+ *  using '/' as separator and with a leading '/' as in the STIL.
+ */
+
+namespace libsidplayfp
+{
+
+const char ERR_OPEN_DIRECTORY[] = "SID CATALOG ERROR: Could not open the collection directory.";
+const char ERR_WRITE_INDEX[]    = "SID CATALOG ERROR: Could not write the index file.";
+
+const char STIL_FILE[]    = "/DOCUMENTS/STIL.txt";
+const char BUGLIST_FILE[] = "/DOCUMENTS/BUGlist.txt";
+
+const uint_least16_t INDEX_VERSION = 1;
+
+const unsigned int HEADER_SIZE = 24;
+const unsigned int TUNE_SIZE = 52;
+const unsigned int FILE_SIZE = 12;
+
+const uint_least32_t NO_LENGTHS = 0xffffffff;
+
+const uint8_t FLAG_STIL = 1 << 0;
+const uint8_t FLAG_BUG  = 1 << 1;
+
+class catalogBuilder
+{
+private:
+    struct fileEntry
+    {
+        std::string path;
+
+        char md5[SidTune::MD5_LENGTH + 1];
+        char md5New[SidTune::MD5_LENGTH + 1];
+
+        uint_least16_t loadAddr;
+        uint_least16_t initAddr;
+        uint_least16_t playAddr;
+        uint_least16_t songs;
+        uint_least16_t startSong;
+
+        uint8_t clockAndCompatibility;
+        uint8_t sidModels;
+        uint8_t sidAddr[2];
+        uint8_t flags;
+
+        unsigned int tune;
+
+        bool valid;
+
+        explicit fileEntry(const std::string& p) :
+            path(p),
+            valid(false) {}
+
+        bool operator<(const fileEntry& other) const { return path < other.path; }
+    };
+
+    typedef std::set<std::string> pathSet_t;
+
+#ifndef _WIN32
+    typedef std::set<std::pair<dev_t, ino_t> > dirSet_t;
+#endif
+
+private:
+    SidDatabase *m_database;
+
+    unsigned int m_threads;
+
+    std::vector<fileEntry> m_files;
+
+    /// Index into m_files of the first file of each tune
+    std::vector<unsigned int> m_tunes;
+
+    /// First song length of each tune
+    std::vector<uint_least32_t> m_firstLength;
+
+    std::vector<uint_least32_t> m_lengths;
+
+    pathSet_t m_stil;
+    pathSet_t m_bugs;
+
+#ifndef _WIN32
+    /// Directories already walked, to break symbolic link cycles
+    dirSet_t m_visited;
+#endif
+
+    const char *m_error;
+
+private:
+    static void loadEntryNames(const std::string& fileName, pathSet_t& names);
+
+    bool walk(const std::string& root, const std::string& dir);
+
+    void scan(const std::string& root, fileEntry& entry) const;
+
+    void collect();
+
+public:
+    catalogBuilder() :
+        m_database(nullptr),
+        m_threads(0),
+        m_error(nullptr) {}
+
+    void setDatabase(SidDatabase *db) { m_database = db; }
+
+    void setThreads(unsigned int threads) { m_threads = threads; }
+
+    bool build(const char *rootDir);
+
+    bool write(const char *fileName);
+
+    unsigned int files() const { return m_files.size(); }
+
+    unsigned int tunes() const { return m_tunes.size(); }
+
+    const char *error() const { return m_error; }
+};
+
+/**
+ * Collect the entry names of a STIL formatted file,
+ * i.e. the lines starting with a slash.
+ */
+void catalogBuilder::loadEntryNames(const std::string& fileName, pathSet_t& names)
+{
+    std::ifstream file(fileName.c_str());
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || (line[0] != '/'))
+            continue;
+
+        const size_t end = line.find_last_not_of(" \t\r");
+        names.insert(line.substr(0, end + 1));
+    }
+}
+
+bool catalogBuilder::walk(const std::string& root, const std::string& dir)
+{
+    std::vector<std::string> dirs;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((root + dir + "/*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+        const char *name = data.cFileName;
+        if ((strcmp(name, ".") == 0) || (strcmp(name, "..") == 0))
+            continue;
+
+        const std::string path = dir + '/' + name;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            // Junctions and directory links may form cycles
+            if (!(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                dirs.push_back(path);
+        }
+        else
+            m_files.push_back(fileEntry(path));
+    }
+    while (FindNextFileA(handle, &data));
+
+    FindClose(handle);
+#else
+    // Symbolic links are followed, but each directory
+    // is entered only once so link cycles terminate
+    struct stat dirSt;
+    if (stat((root + dir).c_str(), &dirSt) != 0)
+        return false;
+
+    if (!m_visited.insert(std::make_pair(dirSt.st_dev, dirSt.st_ino)).second)
+        return true;
+
+    DIR *handle = opendir((root + dir).c_str());
+    if (handle == nullptr)
+        return false;
+
+    while (dirent *entry = readdir(handle))
+    {
+        const char *name = entry->d_name;
+        if ((strcmp(name, ".") == 0) || (strcmp(name, "..") == 0))
+            continue;
+
+        const std::string path = dir + '/' + name;
+
+        struct stat st;
+        if (stat((root + path).c_str(), &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+            dirs.push_back(path);
+        else if (S_ISREG(st.st_mode))
+            m_files.push_back(fileEntry(path));
+    }
+
+    closedir(handle);
+#endif
+
+    for (std::vector<std::string>::const_iterator it = dirs.begin(); it != dirs.end(); ++it)
+    {
+        // Unreadable subdirectories are skipped
+        walk(root, *it);
+    }
+
+    return true;
+}
+
+void catalogBuilder::scan(const std::string& root, fileEntry& entry) const
+{
+    // The mapping is released as soon as the tune is parsed,
+    // so each worker holds at most one file
+    mappedFile file;
+    if (!file.open((root + entry.path).c_str()))
+        return;
+
+    // Larger files are not tunes anyway
+    if (file.size() > 0xffffffff)
+        return;
+
+    try
+    {
+        std::unique_ptr<SidTuneBase> tune(SidTuneBase::readInPlace(file.data(), file.size()));
+        if (tune.get() == nullptr)
+            return;
+
+        tune->createMD5(entry.md5);
+        tune->createMD5New(entry.md5New);
+        if ((entry.md5[0] == '\0') || (entry.md5New[0] == '\0'))
+            return;
+
+        const SidTuneInfo *info = tune->getInfo();
+        entry.loadAddr = info->loadAddr();
+        entry.initAddr = info->initAddr();
+        entry.playAddr = info->playAddr();
+        entry.songs = info->songs();
+        entry.startSong = info->startSong();
+        entry.clockAndCompatibility = info->clockSpeed() | (info->compatibility() << 2);
+
+        entry.sidModels = 0;
+        entry.sidAddr[0] = entry.sidAddr[1] = 0;
+        for (int i = 0; i < info->sidChips(); i++)
+        {
+            entry.sidModels |= info->sidModel(i) << (i * 2);
+            if (i > 0)
+                entry.sidAddr[i - 1] = (info->sidChipBase(i) >> 4) & 0xff;
+        }
+    }
+    catch (loadError const &)
+    {
+        return;
+    }
+
+    entry.flags = 0;
+    if (m_stil.find(entry.path) != m_stil.end())
+        entry.flags |= FLAG_STIL;
+    if (m_bugs.find(entry.path) != m_bugs.end())
+        entry.flags |= FLAG_BUG;
+
+    entry.valid = true;
+}
+
+/**
+ * Drop the unrecognized files, assign the tune records
+ * and fetch the song lengths.
+ * Runs on a single thread as the database is not thread safe.
+ */
+void catalogBuilder::collect()
+{
+    std::vector<fileEntry> files;
+    files.reserve(m_files.size());
+    for (std::vector<fileEntry>::const_iterator it = m_files.begin(); it != m_files.end(); ++it)
+    {
+        if (it->valid)
+            files.push_back(*it);
+    }
+    m_files.swap(files);
+
+    std::map<std::string, unsigned int> known;
+
+    for (unsigned int i = 0; i < m_files.size(); i++)
+    {
+        fileEntry &entry = m_files[i];
+
+        std::map<std::string, unsigned int>::const_iterator it = known.find(entry.md5New);
+        if (it != known.end())
+        {
+            entry.tune = it->second;
+            continue;
+        }
+
+        entry.tune = m_tunes.size();
+        known[entry.md5New] = entry.tune;
+        m_tunes.push_back(i);
+
+        uint_least32_t first = NO_LENGTHS;
+        if (m_database != nullptr)
+        {
+            // Try the current database format first
+            const char *md5 = entry.md5New;
+            if (m_database->lengthMs(md5, 1) < 0)
+                md5 = entry.md5;
+
+            if (m_database->lengthMs(md5, 1) >= 0)
+            {
+                first = m_lengths.size();
+                for (unsigned int song = 1; song <= entry.songs; song++)
+                {
+                    const int_least32_t length = m_database->lengthMs(md5, song);
+                    m_lengths.push_back(length < 0 ? 0 : length);
+                }
+            }
+        }
+        m_firstLength.push_back(first);
+    }
+}
+
+bool catalogBuilder::build(const char *rootDir)
+{
+    m_files.clear();
+    m_tunes.clear();
+    m_firstLength.clear();
+    m_lengths.clear();
+    m_stil.clear();
+    m_bugs.clear();
+
+    std::string root(rootDir);
+    while ((root.size() > 1) && ((root[root.size() - 1] == '/') || (root[root.size() - 1] == '\\')))
+        root.erase(root.size() - 1);
+
+    const bool found = walk(root, std::string());
+#ifndef _WIN32
+    dirSet_t().swap(m_visited);
+#endif
+    if (!found)
+    {
+        m_error = ERR_OPEN_DIRECTORY;
+        return false;
+    }
+
+    std::sort(m_files.begin(), m_files.end());
+
+    loadEntryNames(root + STIL_FILE, m_stil);
+    loadEntryNames(root + BUGLIST_FILE, m_bugs);
+
+    const int count = m_files.size();
+
+#ifdef _OPENMP
+    const int threads = m_threads ? m_threads : omp_get_max_threads();
+#endif
+
+    #pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (int i = 0; i < count; i++)
+    {
+        scan(root, m_files[i]);
+    }
+
+    collect();
+
+    m_error = nullptr;
+    return true;
+}
+
+namespace
+{
+
+void put16(std::vector<uint8_t>& buf, uint_least16_t value)
+{
+    uint8_t tmp[2];
+    endian_little16(tmp, value);
+    buf.insert(buf.end(), tmp, tmp + 2);
+}
+
+void put32(std::vector<uint8_t>& buf, uint_least32_t value)
+{
+    uint8_t tmp[4];
+    endian_little32(tmp, value);
+    buf.insert(buf.end(), tmp, tmp + 4);
+}
+
+void putMD5(std::vector<uint8_t>& buf, const char *md5)
+{
+    for (int i = 0; i < SidTune::MD5_LENGTH; i += 2)
+    {
+        const char hex[3] = { md5[i], md5[i + 1], '\0' };
+        buf.push_back(static_cast<uint8_t>(strtoul(hex, nullptr, 16)));
+    }
+}
+
+}
+
+bool catalogBuilder::write(const char *fileName)
+{
+    std::string strings;
+
+    std::vector<uint8_t> buf;
+    buf.reserve(HEADER_SIZE + m_tunes.size() * TUNE_SIZE + m_files.size() * FILE_SIZE
+                + m_lengths.size() * 4);
+
+    buf.push_back('S');
+    buf.push_back('I');
+    buf.push_back('D');
+    buf.push_back('X');
+    put16(buf, INDEX_VERSION);
+    put16(buf, 0);
+    put32(buf, m_tunes.size());
+    put32(buf, m_files.size());
+    put32(buf, m_lengths.size());
+    // The string table holds every path plus its terminator
+    uint_least32_t stringsSize = 0;
+    for (std::vector<fileEntry>::const_iterator it = m_files.begin(); it != m_files.end(); ++it)
+        stringsSize += it->path.size() + 1;
+    put32(buf, stringsSize);
+
+    for (unsigned int i = 0; i < m_tunes.size(); i++)
+    {
+        const fileEntry &entry = m_files[m_tunes[i]];
+        putMD5(buf, entry.md5);
+        putMD5(buf, entry.md5New);
+        put16(buf, entry.loadAddr);
+        put16(buf, entry.initAddr);
+        put16(buf, entry.playAddr);
+        put16(buf, entry.songs);
+        put16(buf, entry.startSong);
+        buf.push_back(entry.clockAndCompatibility);
+        buf.push_back(entry.sidModels);
+        buf.push_back(entry.sidAddr[0]);
+        buf.push_back(entry.sidAddr[1]);
+        put16(buf, 0);
+        put32(buf, m_firstLength[i]);
+    }
+
+    strings.reserve(stringsSize);
+    for (std::vector<fileEntry>::const_iterator it = m_files.begin(); it != m_files.end(); ++it)
+    {
+        put32(buf, strings.size());
+        put32(buf, it->tune);
+        buf.push_back(it->flags);
+        buf.push_back(0);
+        buf.push_back(0);
+        buf.push_back(0);
+        strings.append(it->path.c_str(), it->path.size() + 1);
+    }
+
+    for (std::vector<uint_least32_t>::const_iterator it = m_lengths.begin(); it != m_lengths.end(); ++it)
+        put32(buf, *it);
+
+    std::ofstream file(fileName, std::ofstream::binary);
+    file.write(reinterpret_cast<const char*>(&buf[0]), buf.size());
+    file.write(strings.data(), strings.size());
+
+    if (file.fail())
+    {
+        m_error = ERR_WRITE_INDEX;
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+//---------------------------------------------------------------------------------------------
+
+SidCatalog::SidCatalog() :
+    builder(*(new libsidplayfp::catalogBuilder())) {}
+
+SidCatalog::~SidCatalog()
+{
+    delete &builder;
+}
+
+void SidCatalog::setSongLengthDatabase(SidDatabase *db)
+{
+    builder.setDatabase(db);
+}
+
+void SidCatalog::setThreads(unsigned int threads)
+{
+    builder.setThreads(threads);
+}
+
+bool SidCatalog::build(const char *rootDir)
+{
+    return builder.build(rootDir);
+}
+
+bool SidCatalog::write(const char *fileName)
+{
+    return builder.write(fileName);
+}
+
+unsigned int SidCatalog::files() const
+{
+    return builder.files();
+}
+
+unsigned int SidCatalog::tunes() const
+{
+    return builder.tunes();
+}
+
+const char *SidCatalog::error() const
+{
+    return builder.error();
+}
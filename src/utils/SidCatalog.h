@@ -0,0 +1,114 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDCATALOG_H
+#define SIDCATALOG_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+class SidDatabase;
+
+namespace libsidplayfp
+{
+class catalogBuilder;
+}
+
+/**
+ * SidCatalog
+ * An utility class to build a metadata index of a tune collection,
+ * e.g. an unpacked HVSC release.
+ *
+ * All the PSID/RSID files under the collection root are parsed
+ * in place and fingerprinted with both MD5 formats. Song lengths
+ * are joined from the songlength database and the STIL and BUGlist
+ * entries are looked up from the collection's DOCUMENTS directory.
+ * Files with identical content are indexed once.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidCatalog
+{
+private:
+    libsidplayfp::catalogBuilder &builder;
+
+public:
+    SidCatalog();
+    ~SidCatalog();
+
+    /**
+     * Set the songlength database used to fill in the song lengths.
+     * The database must stay open during build().
+     *
+     * @param db the songlength database, nullptr to skip the song lengths
+     */
+    void setSongLengthDatabase(SidDatabase *db);
+
+    /**
+     * Set the number of worker threads.
+     * Each worker has at most one file open at any time.
+     * Has effect only if the library is built with OpenMP support.
+     *
+     * @param threads the number of threads, 0 for the default
+     */
+    void setThreads(unsigned int threads);
+
+    /**
+     * Scan a collection.
+     * Files that are not in PSID/RSID format are skipped.
+     * Symbolic links are followed, each directory is scanned once.
+     *
+     * @param rootDir the collection root directory
+     * @return false in case of errors, true otherwise.
+     */
+    bool build(const char *rootDir);
+
+    /**
+     * Write the binary index.
+     * The layout is described in SidCatalog.cpp.
+     *
+     * @param fileName the index file name
+     * @return false in case of errors, true otherwise.
+     */
+    bool write(const char *fileName);
+
+    /**
+     * Get the number of indexed files.
+     */
+    unsigned int files() const;
+
+    /**
+     * Get the number of distinct tunes.
+     */
+    unsigned int tunes() const;
+
+    /**
+     * Get descriptive error message.
+     */
+    const char *error() const;
+
+private:
+    // prevent copying
+    SidCatalog(const SidCatalog&);
+    SidCatalog& operator=(const SidCatalog&);
+};
+
+#endif // SIDCATALOG_H
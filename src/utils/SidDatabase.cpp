@@ -20,8 +20,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 
 #include "SidDatabase.h"
 
@@ -35,10 +37,31 @@
 const char ERR_DATABASE_CORRUPT[]        = "SID DATABASE ERROR: Database seems to be corrupt.";
 const char ERR_NO_DATABASE_LOADED[]      = "SID DATABASE ERROR: Songlength database not loaded.";
 const char ERR_NO_SELECTED_SONG[]        = "SID DATABASE ERROR: No song selected for retrieving song length.";
+const char ERR_NO_MD5[]                  = "SID DATABASE ERROR: Unable to compute the tune MD5.";
 const char ERR_UNABLE_TO_LOAD_DATABASE[] = "SID DATABASE ERROR: Unable to load the songlength database.";
 
 class parseError {};
 
+typedef std::pair<const char*, unsigned int> songRef_t;
+
+/**
+ * Order the requests by hash and subtune.
+ */
+class songOrder
+{
+private:
+    const std::vector<songRef_t> &songs;
+
+public:
+    songOrder(const std::vector<songRef_t> &s) : songs(s) {}
+
+    bool operator()(size_t a, size_t b) const
+    {
+        const int cmp = strcmp(songs[a].first, songs[b].first);
+        return cmp != 0 ? cmp < 0 : songs[a].second < songs[b].second;
+    }
+};
+
 SidDatabase::SidDatabase() :
     m_parser(nullptr),
     errorString(ERR_NO_DATABASE_LOADED)
@@ -215,3 +238,126 @@ int_least32_t SidDatabase::lengthMs(const char *md5, unsigned int song)
 
     return time;
 }
+
+std::vector<int_least32_t> SidDatabase::lengthMs(const std::vector<SidTune*> &tunes)
+{
+    const int count = tunes.size();
+
+    std::vector<char> digests(count * (SidTune::MD5_LENGTH + 1));
+    std::vector<unsigned int> songs(count);
+    // Set for the tunes whose hash could be computed
+    std::vector<char> hashed(count, 0);
+
+    // Each hash goes to its own slot and the tune data is only read
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < count; i++)
+    {
+        SidTune *tune = tunes[i];
+        songs[i] = tune->getInfo()->currentSong();
+        if (songs[i] != 0)
+            hashed[i] = tune->createMD5New(&digests[i * (SidTune::MD5_LENGTH + 1)]) != nullptr;
+    }
+
+    std::vector<songRef_t> refs;
+    refs.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        if (hashed[i])
+            refs.push_back(songRef_t(&digests[i * (SidTune::MD5_LENGTH + 1)], songs[i]));
+    }
+
+    const std::vector<int_least32_t> found = lengthMs(refs);
+
+    std::vector<int_least32_t> lengths(count, -1);
+    std::vector<int_least32_t>::const_iterator it = found.begin();
+    for (int i = 0; i < count; i++)
+    {
+        if (hashed[i])
+            lengths[i] = *it++;
+    }
+
+    // Report the last failed lookup, if it's a hashed tune
+    // the lookup above already did
+    for (int i = count - 1; i >= 0; i--)
+    {
+        if (lengths[i] < 0)
+        {
+            if (!hashed[i])
+                errorString = (songs[i] == 0) ? ERR_NO_SELECTED_SONG : ERR_NO_MD5;
+            break;
+        }
+    }
+
+    return lengths;
+}
+
+std::vector<int_least32_t> SidDatabase::lengthMs(const std::vector<songRef_t> &songs)
+{
+    std::vector<int_least32_t> lengths(songs.size(), -1);
+
+    if (songs.empty())
+        return lengths;
+
+    if (m_parser == nullptr)
+    {
+        errorString = ERR_NO_DATABASE_LOADED;
+        return lengths;
+    }
+
+    if (!m_parser->setSection("Database"))
+    {
+        errorString = ERR_DATABASE_CORRUPT;
+        return lengths;
+    }
+
+    // Visit the requests in hash order so that each entry
+    // is looked up once and its times are parsed in a single pass
+    std::vector<size_t> order(songs.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), songOrder(songs));
+
+    const char *md5 = nullptr;
+    const char *str = nullptr;
+    unsigned int parsed = 0;
+    int_least32_t time = 0;
+
+    for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+    {
+        const songRef_t &song = songs[*it];
+
+        if ((md5 == nullptr) || (strcmp(md5, song.first) != 0))
+        {
+            md5 = song.first;
+            str = m_parser->getValue(md5);
+            parsed = 0;
+            time = 0;
+        }
+
+        // If null then no entry found in database
+        // or the entry is broken
+        if (str == nullptr)
+        {
+            errorString = ERR_DATABASE_CORRUPT;
+            continue;
+        }
+
+        try
+        {
+            for (; parsed < song.second; parsed++)
+            {
+                str = parseTime(str, time);
+            }
+        }
+        catch (parseError const &)
+        {
+            str = nullptr;
+            errorString = ERR_DATABASE_CORRUPT;
+            continue;
+        }
+
+        lengths[*it] = time;
+    }
+
+    return lengths;
+}
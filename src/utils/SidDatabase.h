@@ -25,6 +25,9 @@
 
 #include <stdint.h>
 
+#include <utility>
+#include <vector>
+
 #include "sidplayfp/siddefs.h"
 
 class SidTune;
@@ -101,6 +104,32 @@ public:
      */
     int_least32_t lengthMs(const char *md5, unsigned int song);
 
+    /**
+     * Get the length of the current subtune of many tunes,
+     * e.g. to fill in the durations of a playlist.
+     * The hashes are computed in parallel if the library
+     * is built with OpenMP support, the database entries
+     * are looked up and parsed once for all the requested subtunes.
+     *
+     * @param tunes the SID tunes, the same tune may appear more than once
+     * @return tune lengths in milliseconds, -1 in case of errors.
+     *         error() describes the last failed one, in input order.
+     * @since 2.7
+     */
+    std::vector<int_least32_t> lengthMs(const std::vector<SidTune*> &tunes);
+
+    /**
+     * Get the length of many subtunes.
+     * The database entries are looked up and parsed once
+     * for all the requested subtunes.
+     *
+     * @param songs the md5 hashes and the subtunes
+     * @return tune lengths in milliseconds, -1 in case of errors.
+     *         error() describes the last failed one, in input order.
+     * @since 2.7
+     */
+    std::vector<int_least32_t> lengthMs(const std::vector<std::pair<const char*, unsigned int> > &songs);
+
     /**
      * Get descriptive error message.
      */
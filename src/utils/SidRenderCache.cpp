@@ -0,0 +1,407 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidRenderCache.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <string>
+
+#include "sidplayfp/sidplayfp.h"
+#include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidInfo.h"
+#include "sidplayfp/SidTune.h"
+
+#include "sidcxx11.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_CXX11
+#  include <mutex>
+#endif
+
+namespace libsidplayfp
+{
+
+const char ERR_NOT_DETERMINISTIC[] = "SIDRENDERCACHE ERROR: The engine configuration has no seed";
+const char ERR_NO_MD5[]            = "SIDRENDERCACHE ERROR: Unable to compute the tune MD5";
+
+class renderCache
+{
+private:
+    /// Voices per chip, the fourth one is the digi channel
+    static const unsigned int VOICES = 4;
+
+    struct renderKey
+    {
+        std::string md5;
+        unsigned int song;
+        uint_least64_t config;
+        uint_least64_t roms;
+        uint_least32_t muted;
+        uint_least32_t ms;
+
+        bool operator<(const renderKey& other) const
+        {
+            if (md5 != other.md5)
+                return md5 < other.md5;
+            if (song != other.song)
+                return song < other.song;
+            if (config != other.config)
+                return config < other.config;
+            if (roms != other.roms)
+                return roms < other.roms;
+            if (muted != other.muted)
+                return muted < other.muted;
+            return ms < other.ms;
+        }
+    };
+
+    /// Keys of the entries with samples, most recently used first
+    typedef std::list<const renderKey*> lru_t;
+
+    struct entry_t
+    {
+        uint_least64_t checksum;
+        std::vector<short> pcm;
+        bool hasSamples;
+        lru_t::iterator lru;
+    };
+
+    typedef std::map<renderKey, entry_t> cache_t;
+
+private:
+    const size_t m_maxBytes;
+
+    cache_t m_cache;
+
+    lru_t m_lru;
+
+    size_t m_bytes;
+
+    unsigned int m_hits;
+    unsigned int m_misses;
+
+    const char *m_error;
+
+#ifdef HAVE_CXX11
+    mutable std::mutex m_lock;
+#endif
+
+private:
+    static uint_least64_t fnv(const std::vector<short> &pcm);
+
+    void dropSamples(entry_t &entry);
+
+    void store(const renderKey &key, uint_least64_t checksum, std::vector<short> &pcm);
+
+    void setError(const char *error);
+
+    bool play(sidplayfp &engine, SidTune &tune, uint_least32_t ms, std::vector<short> &pcm);
+
+public:
+    renderCache(size_t maxBytes) :
+        m_maxBytes(maxBytes),
+        m_bytes(0),
+        m_hits(0),
+        m_misses(0),
+        m_error("N/A") {}
+
+    bool get(sidplayfp &engine, SidTune &tune, unsigned int song, uint_least32_t ms,
+             std::vector<short> *pcm, uint_least64_t *checksum);
+
+    void clear();
+
+    unsigned int hits() const;
+    unsigned int misses() const;
+    size_t size() const;
+    const char *error() const;
+};
+
+uint_least64_t renderCache::fnv(const std::vector<short> &pcm)
+{
+    uint_least64_t hash = 0xcbf29ce484222325ULL;
+
+    for (std::vector<short>::const_iterator it = pcm.begin(); it != pcm.end(); ++it)
+    {
+        const unsigned int sample = static_cast<uint16_t>(*it);
+        hash ^= sample & 0xff;
+        hash *= 0x100000001b3ULL;
+        hash ^= sample >> 8;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+void renderCache::dropSamples(entry_t &entry)
+{
+    m_bytes -= entry.pcm.size() * sizeof(short);
+    std::vector<short>().swap(entry.pcm);
+    entry.hasSamples = false;
+    m_lru.erase(entry.lru);
+}
+
+void renderCache::store(const renderKey &key, uint_least64_t checksum, std::vector<short> &pcm)
+{
+    cache_t::iterator it = m_cache.find(key);
+    if (it == m_cache.end())
+    {
+        entry_t entry;
+        entry.checksum = checksum;
+        entry.hasSamples = false;
+        it = m_cache.insert(cache_t::value_type(key, entry)).first;
+    }
+
+    entry_t &entry = it->second;
+    if (entry.hasSamples)
+        return;
+
+    const size_t bytes = pcm.size() * sizeof(short);
+    if (bytes > m_maxBytes)
+        return;
+
+    // Make room dropping the least recently used samples
+    while (m_bytes + bytes > m_maxBytes)
+    {
+        dropSamples(m_cache.find(*m_lru.back())->second);
+    }
+
+    entry.pcm = pcm;
+    entry.hasSamples = true;
+    entry.lru = m_lru.insert(m_lru.begin(), &it->first);
+    m_bytes += bytes;
+}
+
+void renderCache::setError(const char *error)
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    m_error = error;
+}
+
+bool renderCache::play(sidplayfp &engine, SidTune &tune, uint_least32_t ms, std::vector<short> &pcm)
+{
+    if (!engine.load(&tune))
+    {
+        setError(engine.error());
+        return false;
+    }
+
+    const unsigned int channels = engine.info().channels();
+    const double rate = engine.info().sampleRate();
+
+    const uint_least32_t count = static_cast<uint_least32_t>(rate * ms / 1000. + 0.5) * channels;
+
+    // Play in fixed size chunks so that the output
+    // does not depend on the requested duration
+    const uint_least32_t chunk = static_cast<uint_least32_t>(rate / 50.) * channels;
+
+    pcm.resize(count);
+
+    std::vector<short> buffer(chunk);
+    uint_least32_t pos = 0;
+    while (pos < count)
+    {
+        if (engine.play(&buffer[0], chunk) < chunk)
+        {
+            setError(engine.error());
+            return false;
+        }
+
+        const uint_least32_t n = std::min(chunk, count - pos);
+        std::copy(buffer.begin(), buffer.begin() + n, pcm.begin() + pos);
+        pos += n;
+    }
+
+    return true;
+}
+
+bool renderCache::get(sidplayfp &engine, SidTune &tune, unsigned int song, uint_least32_t ms,
+                      std::vector<short> *pcm, uint_least64_t *checksum)
+{
+    const SidConfig &cfg = engine.config();
+    if (cfg.seed == 0)
+    {
+        setError(ERR_NOT_DETERMINISTIC);
+        return false;
+    }
+
+    renderKey key;
+    key.song = tune.selectSong(song);
+    key.config = cfg.hash();
+    key.roms = engine.info().romDigest();
+
+    // Voices of up to three chips
+    key.muted = 0;
+    for (unsigned int i = 0; i < 3 * VOICES; i++)
+    {
+        if (engine.isMuted(i / VOICES, i % VOICES))
+            key.muted |= 1 << i;
+    }
+    key.ms = ms;
+
+    const char *md5 = tune.createMD5New();
+    if (md5 == nullptr)
+    {
+        setError(ERR_NO_MD5);
+        return false;
+    }
+    key.md5 = md5;
+
+    {
+#ifdef HAVE_CXX11
+        std::lock_guard<std::mutex> lock(m_lock);
+#endif
+        cache_t::iterator it = m_cache.find(key);
+        if (it != m_cache.end() && (pcm == nullptr || it->second.hasSamples))
+        {
+            entry_t &entry = it->second;
+            if (pcm != nullptr)
+            {
+                *pcm = entry.pcm;
+                m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+            }
+            if (checksum != nullptr)
+                *checksum = entry.checksum;
+
+            m_hits++;
+            return true;
+        }
+
+        m_misses++;
+    }
+
+    // Render without holding the lock
+    std::vector<short> samples;
+    if (!play(engine, tune, ms, samples))
+        return false;
+
+    const uint_least64_t sum = fnv(samples);
+
+    {
+#ifdef HAVE_CXX11
+        std::lock_guard<std::mutex> lock(m_lock);
+#endif
+        store(key, sum, samples);
+    }
+
+    if (pcm != nullptr)
+        pcm->swap(samples);
+    if (checksum != nullptr)
+        *checksum = sum;
+
+    return true;
+}
+
+void renderCache::clear()
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    m_cache.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+unsigned int renderCache::hits() const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    return m_hits;
+}
+
+unsigned int renderCache::misses() const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    return m_misses;
+}
+
+size_t renderCache::size() const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    return m_bytes;
+}
+
+const char *renderCache::error() const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    return m_error;
+}
+
+}
+
+//-----------------------------------------------------------------------------
+
+SidRenderCache::SidRenderCache(size_t maxBytes) :
+    cache(*(new libsidplayfp::renderCache(maxBytes))) {}
+
+SidRenderCache::~SidRenderCache()
+{
+    delete &cache;
+}
+
+bool SidRenderCache::render(sidplayfp &engine, SidTune &tune, unsigned int song,
+                            uint_least32_t ms, std::vector<short> &pcm)
+{
+    return cache.get(engine, tune, song, ms, &pcm, nullptr);
+}
+
+bool SidRenderCache::checksum(sidplayfp &engine, SidTune &tune, unsigned int song,
+                              uint_least32_t ms, uint_least64_t &checksum)
+{
+    return cache.get(engine, tune, song, ms, nullptr, &checksum);
+}
+
+void SidRenderCache::clear()
+{
+    cache.clear();
+}
+
+unsigned int SidRenderCache::hits() const
+{
+    return cache.hits();
+}
+
+unsigned int SidRenderCache::misses() const
+{
+    return cache.misses();
+}
+
+size_t SidRenderCache::size() const
+{
+    return cache.size();
+}
+
+const char *SidRenderCache::error() const
+{
+    return cache.error();
+}
@@ -0,0 +1,131 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDRENDERCACHE_H
+#define SIDRENDERCACHE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#include "sidplayfp/siddefs.h"
+
+class sidplayfp;
+class SidTune;
+
+namespace libsidplayfp
+{
+class renderCache;
+}
+
+/**
+ * SidRenderCache
+ * An utility class to reuse the output of deterministic renderings.
+ *
+ * Renderings are keyed by the tune MD5 (new format), the song number,
+ * the engine configuration hash, which covers the builder settings,
+ * the digest of the loaded ROM images, the muted voices
+ * and the duration. The engine must be configured with a non zero
+ * SidConfig::seed so that the output only depends on the key.
+ * The samples are kept within a memory budget, the least recently used
+ * ones are dropped first, while the checksums of all the renderings
+ * are kept.
+ * Renderings can be requested from multiple threads, each with its own
+ * engine and its own SidTune: the song is selected on the given tune,
+ * so the same SidTune object must not be used by concurrent calls.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidRenderCache
+{
+private:
+    libsidplayfp::renderCache &cache;
+
+public:
+    /**
+     * @param maxBytes the memory budget for the cached samples
+     */
+    SidRenderCache(size_t maxBytes);
+    ~SidRenderCache();
+
+    /**
+     * Render a song or get it from the cache.
+     * On a miss the tune is loaded into the engine and played
+     * from the start of the song.
+     * The song is selected on the tune and stays selected.
+     *
+     * @param engine the engine, already configured
+     * @param tune the tune
+     * @param song the song number, 0 for the start song
+     * @param ms the duration in milliseconds
+     * @param pcm filled with the 16 bit samples, interleaved if stereo
+     * @return false in case of errors, true otherwise.
+     */
+    bool render(sidplayfp &engine, SidTune &tune, unsigned int song,
+                uint_least32_t ms, std::vector<short> &pcm);
+
+    /**
+     * Get the checksum of a rendering, rendering the song
+     * only if it was never rendered before.
+     * The checksum is the 64 bit FNV-1a hash of the samples
+     * taken as little endian 16 bit values.
+     *
+     * @param engine the engine, already configured
+     * @param tune the tune
+     * @param song the song number, 0 for the start song
+     * @param ms the duration in milliseconds
+     * @param checksum set to the checksum of the samples
+     * @return false in case of errors, true otherwise.
+     */
+    bool checksum(sidplayfp &engine, SidTune &tune, unsigned int song,
+                uint_least32_t ms, uint_least64_t &checksum);
+
+    /**
+     * Drop all the cached renderings.
+     */
+    void clear();
+
+    /**
+     * Get the number of requests served from the cache.
+     */
+    unsigned int hits() const;
+
+    /**
+     * Get the number of requests that needed rendering.
+     */
+    unsigned int misses() const;
+
+    /**
+     * Get the memory used by the cached samples, in bytes.
+     */
+    size_t size() const;
+
+    /**
+     * Get descriptive error message.
+     */
+    const char *error() const;
+
+private:
+    // prevent copying
+    SidRenderCache(const SidRenderCache&);
+    SidRenderCache& operator=(const SidRenderCache&);
+};
+
+#endif // SIDRENDERCACHE_H
@@ -0,0 +1,340 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidScheduler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "sidplayfp/sidplayfp.h"
+#include "sidplayfp/SidInfo.h"
+
+#include "sidcxx11.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_CXX11
+#  include <mutex>
+#endif
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+namespace libsidplayfp
+{
+
+class streamScheduler
+{
+private:
+    struct stream_t
+    {
+        sidplayfp *engine;
+
+        /// Output ring buffer
+        std::vector<short> ring;
+        uint_least32_t readPos;
+        uint_least32_t fill;
+
+        /// Rendering buffer, used by one worker at a time
+        std::vector<short> quantum;
+
+        /// Samples per millisecond, all channels included
+        double samplesPerMs;
+
+        bool stopped;
+
+#ifdef HAVE_CXX11
+        mutable std::mutex lock;
+#endif
+    };
+
+    /// Deadline in milliseconds and stream
+    typedef std::pair<double, stream_t*> ready_t;
+
+private:
+    const unsigned int m_bufferMs;
+    const unsigned int m_quantumMs;
+
+    /// Streams by id, removed ones are null
+    std::vector<stream_t*> m_streams;
+
+    unsigned int m_threads;
+
+#ifdef HAVE_CXX11
+    /**
+     * Guards the stream table against the readers.
+     * Taken before the stream locks, a stream is deleted
+     * only while holding it.
+     */
+    mutable std::mutex m_lock;
+#endif
+
+private:
+    stream_t *get(unsigned int id) const { return id < m_streams.size() ? m_streams[id] : nullptr; }
+
+    static void render(stream_t &s);
+
+public:
+    streamScheduler(unsigned int bufferMs, unsigned int quantumMs) :
+        m_bufferMs(bufferMs),
+        m_quantumMs(std::max(quantumMs, 5u)),
+        m_threads(0) {}
+
+    ~streamScheduler();
+
+    void setThreads(unsigned int threads) { m_threads = threads; }
+
+    unsigned int addStream(sidplayfp *engine);
+    void removeStream(unsigned int id);
+
+    unsigned int run();
+
+    uint_least32_t read(unsigned int id, short *buffer, uint_least32_t count);
+    uint_least32_t available(unsigned int id) const;
+    bool stopped(unsigned int id) const;
+};
+
+streamScheduler::~streamScheduler()
+{
+    for (std::vector<stream_t*>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+    {
+        delete *it;
+    }
+}
+
+unsigned int streamScheduler::addStream(sidplayfp *engine)
+{
+    const unsigned int channels = engine->info().channels();
+    const uint_least32_t rate = engine->info().sampleRate();
+
+    // Whole frames only
+    const uint_least32_t quantum = (rate * m_quantumMs / 1000) * channels;
+    const uint_least32_t size = std::max((rate * m_bufferMs / 1000) * channels, quantum);
+
+    stream_t *s = new stream_t;
+    s->engine = engine;
+    s->ring.resize(size);
+    s->readPos = 0;
+    s->fill = 0;
+    s->quantum.resize(quantum);
+    s->samplesPerMs = (rate * channels) / 1000.;
+    s->stopped = false;
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    // Reuse the slot of a removed stream
+    std::vector<stream_t*>::iterator it = std::find(m_streams.begin(), m_streams.end(), static_cast<stream_t*>(nullptr));
+    if (it != m_streams.end())
+    {
+        *it = s;
+        return it - m_streams.begin();
+    }
+
+    m_streams.push_back(s);
+    return m_streams.size() - 1;
+}
+
+void streamScheduler::removeStream(unsigned int id)
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(m_lock);
+#endif
+    if (id < m_streams.size())
+    {
+        delete m_streams[id];
+        m_streams[id] = nullptr;
+    }
+}
+
+void streamScheduler::render(stream_t &s)
+{
+    const uint_least32_t count = s.quantum.size();
+    const uint_least32_t played = s.engine->play(&s.quantum[0], count);
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(s.lock);
+#endif
+    const uint_least32_t size = s.ring.size();
+    uint_least32_t writePos = (s.readPos + s.fill) % size;
+    for (uint_least32_t i = 0; i < played; i++)
+    {
+        s.ring[writePos] = s.quantum[i];
+        if (++writePos == size)
+            writePos = 0;
+    }
+    s.fill += played;
+
+    if (played < count)
+        s.stopped = true;
+}
+
+unsigned int streamScheduler::run()
+{
+    std::vector<ready_t> ready;
+
+    {
+        // Streams are removed from this same thread,
+        // so they stay valid while rendering
+#ifdef HAVE_CXX11
+        std::lock_guard<std::mutex> tableLock(m_lock);
+#endif
+        ready.reserve(m_streams.size());
+
+        for (std::vector<stream_t*>::const_iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+        {
+            stream_t *s = *it;
+            if (s == nullptr)
+                continue;
+
+#ifdef HAVE_CXX11
+            std::lock_guard<std::mutex> lock(s->lock);
+#endif
+            if (!s->stopped && (s->ring.size() - s->fill >= s->quantum.size()))
+            {
+                ready.push_back(ready_t(s->fill / s->samplesPerMs, s));
+            }
+        }
+    }
+
+    // Earliest deadline first, dynamic scheduling
+    // hands out the iterations in order
+    std::sort(ready.begin(), ready.end());
+
+    const int count = ready.size();
+
+#ifdef _OPENMP
+    const int threads = m_threads ? m_threads : omp_get_max_threads();
+#endif
+
+    #pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (int i = 0; i < count; i++)
+    {
+        render(*ready[i].second);
+    }
+
+    return count;
+}
+
+uint_least32_t streamScheduler::read(unsigned int id, short *buffer, uint_least32_t count)
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> tableLock(m_lock);
+#endif
+    stream_t *s = get(id);
+    if (s == nullptr)
+        return 0;
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(s->lock);
+#endif
+    const uint_least32_t size = s->ring.size();
+    const uint_least32_t n = std::min(count, s->fill);
+    for (uint_least32_t i = 0; i < n; i++)
+    {
+        buffer[i] = s->ring[s->readPos];
+        if (++s->readPos == size)
+            s->readPos = 0;
+    }
+    s->fill -= n;
+
+    return n;
+}
+
+uint_least32_t streamScheduler::available(unsigned int id) const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> tableLock(m_lock);
+#endif
+    const stream_t *s = get(id);
+    if (s == nullptr)
+        return 0;
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(s->lock);
+#endif
+    return s->fill;
+}
+
+bool streamScheduler::stopped(unsigned int id) const
+{
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> tableLock(m_lock);
+#endif
+    const stream_t *s = get(id);
+    if (s == nullptr)
+        return true;
+
+#ifdef HAVE_CXX11
+    std::lock_guard<std::mutex> lock(s->lock);
+#endif
+    return s->stopped;
+}
+
+}
+
+//-----------------------------------------------------------------------------
+
+SidScheduler::SidScheduler(unsigned int bufferMs, unsigned int quantumMs) :
+    scheduler(*(new libsidplayfp::streamScheduler(bufferMs, quantumMs))) {}
+
+SidScheduler::~SidScheduler()
+{
+    delete &scheduler;
+}
+
+void SidScheduler::setThreads(unsigned int threads)
+{
+    scheduler.setThreads(threads);
+}
+
+unsigned int SidScheduler::addStream(sidplayfp *engine)
+{
+    return scheduler.addStream(engine);
+}
+
+void SidScheduler::removeStream(unsigned int id)
+{
+    scheduler.removeStream(id);
+}
+
+unsigned int SidScheduler::run()
+{
+    return scheduler.run();
+}
+
+uint_least32_t SidScheduler::read(unsigned int id, short *buffer, uint_least32_t count)
+{
+    return scheduler.read(id, buffer, count);
+}
+
+uint_least32_t SidScheduler::available(unsigned int id) const
+{
+    return scheduler.available(id);
+}
+
+bool SidScheduler::stopped(unsigned int id) const
+{
+    return scheduler.stopped(id);
+}
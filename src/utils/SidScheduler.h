@@ -0,0 +1,134 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDSCHEDULER_H
+#define SIDSCHEDULER_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+class sidplayfp;
+
+namespace libsidplayfp
+{
+class streamScheduler;
+}
+
+/**
+ * SidScheduler
+ * An utility class to serve many real-time streams
+ * from a fixed pool of threads.
+ *
+ * Each stream is an engine, already configured and loaded,
+ * with an output buffer. Every scheduling round the streams
+ * whose buffer has room for a quantum are sorted by deadline,
+ * i.e. the time left before their buffer runs dry, and the
+ * earliest ones are handed out to the threads first.
+ * Each stream renders a single quantum per round so the
+ * rounds stay short and no stream can starve the others.
+ *
+ * The streams are added, removed and scheduled from a single
+ * control thread, the buffered samples can be read from any thread,
+ * also while the stream is being removed.
+ * Without C++11 support the library has no locking and all the calls
+ * must come from the control thread.
+ *
+ * @since 2.7
+ */
+class SID_EXTERN SidScheduler
+{
+private:
+    libsidplayfp::streamScheduler &scheduler;
+
+public:
+    /**
+     * @param bufferMs the length of each stream buffer in milliseconds
+     * @param quantumMs the length of the rendered quanta in milliseconds,
+     *        at least 5
+     */
+    SidScheduler(unsigned int bufferMs, unsigned int quantumMs);
+    ~SidScheduler();
+
+    /**
+     * Set the number of worker threads.
+     * Has effect only if the library is built with OpenMP support.
+     *
+     * @param threads the number of threads, 0 for the default
+     */
+    void setThreads(unsigned int threads);
+
+    /**
+     * Add a stream.
+     * The engine is not owned by the scheduler and
+     * must not be used elsewhere until the stream is removed.
+     *
+     * @param engine the engine, already configured and loaded
+     * @return the stream id
+     */
+    unsigned int addStream(sidplayfp *engine);
+
+    /**
+     * Remove a stream, dropping the buffered samples.
+     *
+     * @param id the stream id
+     */
+    void removeStream(unsigned int id);
+
+    /**
+     * Run a scheduling round.
+     * Should be called at least once every quantum.
+     *
+     * @return the number of rendered quanta
+     */
+    unsigned int run();
+
+    /**
+     * Get the buffered samples of a stream.
+     *
+     * @param id the stream id
+     * @param buffer the buffer to fill, interleaved if stereo
+     * @param count the size of the buffer in 16 bit samples
+     * @return the number of copied samples
+     */
+    uint_least32_t read(unsigned int id, short *buffer, uint_least32_t count);
+
+    /**
+     * Get the number of buffered samples of a stream.
+     *
+     * @param id the stream id
+     */
+    uint_least32_t available(unsigned int id) const;
+
+    /**
+     * Check if a stream has stopped because of an error.
+     * The error is reported by the engine.
+     *
+     * @param id the stream id
+     */
+    bool stopped(unsigned int id) const;
+
+private:
+    // prevent copying
+    SidScheduler(const SidScheduler&);
+    SidScheduler& operator=(const SidScheduler&);
+};
+
+#endif // SIDSCHEDULER_H
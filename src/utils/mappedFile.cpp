@@ -0,0 +1,150 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "mappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#include "sidcxx11.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef _WIN32
+#  include <windows.h>
+#elif defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define USE_MMAP
+#endif
+
+namespace libsidplayfp
+{
+
+mappedFile::mappedFile() :
+    m_data(nullptr),
+    m_size(0)
+#ifdef _WIN32
+    , m_mapping(nullptr)
+#endif
+{}
+
+mappedFile::~mappedFile()
+{
+    close();
+}
+
+bool mappedFile::open(const char* fileName)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The mapping keeps its own reference to the file
+    CloseHandle(file);
+    if (mapping == nullptr)
+        return false;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+#elif defined(USE_MMAP)
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = st.st_size;
+    return true;
+#else
+    std::ifstream inFile(fileName, std::ifstream::binary);
+    if (!inFile.is_open())
+        return false;
+
+    m_buffer.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+    if (inFile.bad() || m_buffer.empty())
+    {
+        m_buffer.clear();
+        return false;
+    }
+
+    m_data = &m_buffer[0];
+    m_size = m_buffer.size();
+    return true;
+#endif
+}
+
+void mappedFile::close()
+{
+    if (m_data == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#elif defined(USE_MMAP)
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#else
+    std::vector<uint8_t>().swap(m_buffer);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * Read only view of a whole file.
+ *
+ * The file is memory mapped where supported,
+ * otherwise it is read into memory.
+ */
+class mappedFile
+{
+private:
+    const uint8_t* m_data;
+
+    size_t m_size;
+
+#ifdef _WIN32
+    void* m_mapping;
+#endif
+
+    /// Fallback storage when mapping is not available
+    std::vector<uint8_t> m_buffer;
+
+public:
+    mappedFile();
+    ~mappedFile();
+
+    /**
+     * Map a file.
+     *
+     * @param fileName the file to map
+     * @return false if the file can not be opened
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Release the file.
+     */
+    void close();
+
+    /**
+     * The file contents, 0 if no file is open.
+     */
+    const uint8_t* data() const { return m_data; }
+
+    /**
+     * The file size.
+     */
+    size_t size() const { return m_size; }
+
+private:
+    // prevent copying
+    mappedFile(const mappedFile&);
+    mappedFile& operator=(const mappedFile&);
+};
+
+}
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,236 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/utils/SidCatalog.h"
+#include "../src/utils/SidDatabase.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace UnitTest;
+
+#define ROOT "TestCatalog.dir"
+
+uint8_t const bufferRSID[128] = {
+    0x52, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x00, 0x00,             // loadAddress
+    0x00, 0x00,             // initAddress
+    0x00, 0x00,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x00,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    0xe8, 0x07, 0x00, 0x00  // data
+};
+
+#define DATA_BYTE 126
+
+/**
+ * Read back the binary index.
+ */
+class indexReader
+{
+private:
+    std::vector<uint8_t> m_data;
+
+public:
+    explicit indexReader(const char* fileName)
+    {
+        std::ifstream file(fileName, std::ifstream::binary);
+        m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    size_t size() const { return m_data.size(); }
+
+    unsigned int get16(size_t pos) const { return m_data[pos] | (m_data[pos + 1] << 8); }
+    uint32_t get32(size_t pos) const { return get16(pos) | (static_cast<uint32_t>(get16(pos + 2)) << 16); }
+
+    bool magic() const { return memcmp(&m_data[0], "SIDX", 4) == 0; }
+    unsigned int tunes() const { return get32(0x08); }
+    unsigned int files() const { return get32(0x0c); }
+    unsigned int lengths() const { return get32(0x10); }
+
+    size_t tune(unsigned int i) const { return 24 + i * 52; }
+    size_t file(unsigned int i) const { return tune(tunes()) + i * 12; }
+    size_t length(unsigned int i) const { return file(files()) + i * 4; }
+
+    std::string path(unsigned int i) const
+    {
+        return std::string(reinterpret_cast<const char*>(&m_data[length(lengths()) + get32(file(i))]));
+    }
+
+    unsigned int fileTune(unsigned int i) const { return get32(file(i) + 4); }
+    unsigned int fileFlags(unsigned int i) const { return m_data[file(i) + 8]; }
+};
+
+void writeFile(const std::string& name, const void* data, size_t size)
+{
+    std::ofstream file(name.c_str(), std::ofstream::binary);
+    file.write(static_cast<const char*>(data), size);
+}
+
+void writeFile(const std::string& name, const std::string& text)
+{
+    writeFile(name, text.data(), text.size());
+}
+
+SUITE(Catalog)
+{
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture()
+    {
+        mkdir(ROOT, 0755);
+        mkdir(ROOT "/C64Music", 0755);
+        mkdir(ROOT "/C64Music/A", 0755);
+        mkdir(ROOT "/C64Music/B", 0755);
+        mkdir(ROOT "/C64Music/DOCUMENTS", 0755);
+
+        uint8_t data[sizeof(bufferRSID)];
+        memcpy(data, bufferRSID, sizeof(data));
+        writeFile(ROOT "/C64Music/A/a.sid", data, sizeof(data));
+        writeFile(ROOT "/C64Music/A/dup.sid", data, sizeof(data));
+
+        SidTune tune(data, sizeof(data));
+        tune.createMD5New(md5);
+
+        data[DATA_BYTE] = 0x01;
+        writeFile(ROOT "/C64Music/B/b.sid", data, sizeof(data));
+        writeFile(ROOT "/C64Music/B/readme.txt", "not a tune");
+
+        writeFile(ROOT "/C64Music/DOCUMENTS/STIL.txt", "/A/a.sid\nCOMMENT: test\n");
+        writeFile(ROOT "/C64Music/DOCUMENTS/BUGlist.txt", "/B/b.sid\r\nBUG: test\r\n");
+
+        writeFile(ROOT "/Songlengths.md5", std::string("[Database]\n") + md5 + "=1:02.5\n");
+
+        // A link back to the root
+        symlink("..", ROOT "/C64Music/B/loop");
+    }
+
+    ~TestFixture()
+    {
+        const char* files[] =
+        {
+            ROOT "/C64Music/A/a.sid",
+            ROOT "/C64Music/A/dup.sid",
+            ROOT "/C64Music/B/b.sid",
+            ROOT "/C64Music/B/readme.txt",
+            ROOT "/C64Music/B/loop",
+            ROOT "/C64Music/DOCUMENTS/STIL.txt",
+            ROOT "/C64Music/DOCUMENTS/BUGlist.txt",
+            ROOT "/Songlengths.md5",
+            ROOT "/index.bin",
+        };
+        for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+            unlink(files[i]);
+
+        rmdir(ROOT "/C64Music/A");
+        rmdir(ROOT "/C64Music/B");
+        rmdir(ROOT "/C64Music/DOCUMENTS");
+        rmdir(ROOT "/C64Music");
+        rmdir(ROOT);
+    }
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    SidCatalog catalog;
+};
+
+TEST_FIXTURE(TestFixture, TestMissingRoot)
+{
+    CHECK(!catalog.build(ROOT "/missing"));
+    CHECK(catalog.error() != nullptr);
+}
+
+TEST_FIXTURE(TestFixture, TestWalk)
+{
+    // The link cycle is entered only once
+    CHECK(catalog.build(ROOT "/C64Music/"));
+    CHECK_EQUAL(3U, catalog.files());
+    CHECK_EQUAL(2U, catalog.tunes());
+}
+
+TEST_FIXTURE(TestFixture, TestIndex)
+{
+    SidDatabase db;
+    CHECK(db.open(ROOT "/Songlengths.md5"));
+    catalog.setSongLengthDatabase(&db);
+
+    CHECK(catalog.build(ROOT "/C64Music"));
+    CHECK(catalog.write(ROOT "/index.bin"));
+
+    indexReader index(ROOT "/index.bin");
+    CHECK(index.size() > 24);
+    CHECK(index.magic());
+    CHECK_EQUAL(1U, index.get16(0x04));
+    CHECK_EQUAL(2U, index.tunes());
+    CHECK_EQUAL(3U, index.files());
+    CHECK_EQUAL(1U, index.lengths());
+
+    // Files are sorted by path
+    CHECK_EQUAL("/A/a.sid", index.path(0));
+    CHECK_EQUAL("/A/dup.sid", index.path(1));
+    CHECK_EQUAL("/B/b.sid", index.path(2));
+
+    // Identical files share the tune record
+    CHECK_EQUAL(index.fileTune(0), index.fileTune(1));
+    CHECK(index.fileTune(0) != index.fileTune(2));
+
+    CHECK_EQUAL(1U, index.fileFlags(0));
+    CHECK_EQUAL(0U, index.fileFlags(1));
+    CHECK_EQUAL(2U, index.fileFlags(2));
+
+    const size_t a = index.tune(index.fileTune(0));
+    const size_t b = index.tune(index.fileTune(2));
+    CHECK_EQUAL(0x07e8U, index.get16(a + 0x20));
+    CHECK_EQUAL(1U, index.get16(a + 0x26));
+
+    // Song lengths are joined on the new MD5
+    CHECK_EQUAL(0U, index.get32(a + 0x30));
+    CHECK_EQUAL(62500U, index.get32(index.length(0)));
+    CHECK_EQUAL(0xffffffffU, index.get32(b + 0x30));
+}
+
+}
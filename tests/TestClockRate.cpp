@@ -0,0 +1,165 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidInfo.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+#include "../src/builders/residfp-builder/residfp/resample/BoxcarResampler.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+using namespace UnitTest;
+
+/// PAL CPU clock
+#define PAL_CLOCK 985248.
+
+SUITE(ClockRate)
+{
+
+TEST(TestBoxcarPassThrough)
+{
+    reSIDfp::BoxcarResampler r(PAL_CLOCK, PAL_CLOCK);
+
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK(r.input(i * 100));
+        CHECK_EQUAL(i * 100, r.getOutput());
+    }
+}
+
+TEST(TestBoxcarAverage)
+{
+    // 985248 / 48000 rounds to 21
+    reSIDfp::BoxcarResampler r(PAL_CLOCK, 48000.);
+
+    int outputs = 0;
+    for (int i = 1; i <= 21 * 10; i++)
+    {
+        if (r.input(i))
+        {
+            // Average of a ramp over the last 21 inputs
+            CHECK_EQUAL(i - 10, r.getOutput());
+            outputs++;
+        }
+    }
+    CHECK_EQUAL(10, outputs);
+}
+
+/*
+ * init ($1000):
+ *     LDA #$0F : STA $D418
+ *     LDA #$F0 : STA $D406
+ *     LDA #$11 : STA $D401
+ *     LDA #$21 : STA $D404  ; sawtooth, gate on
+ *     RTS
+ */
+const uint8_t initCode[] =
+{
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0xA9, 0xF0, 0x8D, 0x06, 0xD4,
+    0xA9, 0x11, 0x8D, 0x01, 0xD4,
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0x60
+};
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        rs("ReSIDfp"),
+        data(makeTune(initCode, sizeof(initCode), nullptr, 0)),
+        tune(&data[0], data.size()),
+        cfg(makeConfig(&rs))
+    {
+        rs.create(1);
+
+        cfg.samplingMethod = SidConfig::CLOCK_RATE;
+        cfg.frequency = 985248;
+
+        tune.selectSong(0);
+    }
+
+    ReSIDfpBuilder rs;
+    std::vector<uint8_t> data;
+    SidTune tune;
+    SidConfig cfg;
+    sidplayfp engine;
+};
+
+TEST_FIXTURE(TestFixture, TestSampleRate)
+{
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+    CHECK_CLOSE(PAL_CLOCK, engine.info().sampleRate(), 1.);
+
+    cfg.frequency = 48000;
+    CHECK(engine.config(cfg));
+    CHECK_CLOSE(PAL_CLOCK / 21., engine.info().sampleRate(), 1.);
+}
+
+TEST_FIXTURE(TestFixture, TestPlay)
+{
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+
+    // A second at once
+    std::vector<short> buffer(985248);
+    CHECK_EQUAL(985248U, engine.play(&buffer[0], buffer.size()));
+
+    // The sawtooth is playing
+    short low = buffer[0], high = buffer[0];
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        low = std::min(low, buffer[i]);
+        high = std::max(high, buffer[i]);
+    }
+    CHECK(high - low > 1000);
+
+    // Small buffers, leaving most of every batch to the next calls
+    for (int i = 0; i < 10000; i++)
+        CHECK_EQUAL(2U, engine.play(&buffer[0], 2));
+
+    // Discarding
+    CHECK_EQUAL(0U, engine.play(nullptr, 0));
+    CHECK_EQUAL(100U, engine.play(&buffer[0], 100));
+}
+
+TEST_FIXTURE(TestFixture, TestFastForward)
+{
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+    CHECK(engine.fastForward(3200));
+
+    std::vector<short> buffer(10000);
+    for (int i = 0; i < 10; i++)
+        CHECK_EQUAL(10000U, engine.play(&buffer[0], buffer.size()));
+    CHECK_EQUAL(3U, engine.play(&buffer[0], 3));
+}
+
+}
@@ -23,6 +23,9 @@
 
 #include "../src/builders/residfp-builder/residfp/Dac.h"
 #include "../src/builders/residfp-builder/residfp/Dac.cpp"
+#include "../src/builders/residfp-builder/residfp/Voice.h"
+
+#include <cstdlib>
 
 using namespace UnitTest;
 using namespace reSIDfp;
@@ -71,4 +74,58 @@ TEST(TestDac8580)
     CHECK(isDacLinear(MOS8580));
 }
 
+/**
+ * Count the (waveform, envelope) pairs where the output
+ * of the voice DAC tables differs from the float product
+ * of the DAC outputs.
+ *
+ * @return the largest difference
+ */
+int voiceDeviation(ChipModel chipModel, unsigned int &differing)
+{
+    int wavFixed[1 << OSC_DAC_BITS];
+    int64_t envFixed[1 << ENV_DAC_BITS];
+    buildVoiceDacs(chipModel, wavFixed, envFixed);
+
+    float envFloat[1 << ENV_DAC_BITS];
+    buildDac(envFloat, chipModel);
+
+    Dac dacBuilder(OSC_DAC_BITS);
+    dacBuilder.kinkedDac(chipModel);
+    const double offset = dacBuilder.getOutput(chipModel == MOS6581 ? OFFSET_6581 : OFFSET_8580);
+
+    int deviation = 0;
+    differing = 0;
+    for (unsigned int wav = 0; wav < (1 << OSC_DAC_BITS); wav++)
+    {
+        const float wavFloat = static_cast<float>(dacBuilder.getOutput(wav) - offset);
+
+        for (unsigned int env = 0; env < (1 << ENV_DAC_BITS); env++)
+        {
+            const int expected = static_cast<int>(wavFloat * envFloat[env]);
+            const int diff = std::abs(Voice::multiply(wavFixed[wav], envFixed[env]) - expected);
+            if (diff != 0)
+                differing++;
+            if (diff > deviation)
+                deviation = diff;
+        }
+    }
+
+    return deviation;
+}
+
+TEST(TestVoiceOutput)
+{
+    // The fixed point output is within one of the float product
+    // for about 1% of the pairs
+    const unsigned int pairs = (1 << OSC_DAC_BITS) * (1 << ENV_DAC_BITS);
+
+    unsigned int differing;
+    CHECK(voiceDeviation(MOS6581, differing) <= 1);
+    CHECK(differing < pairs / 50);
+
+    CHECK(voiceDeviation(MOS8580, differing) <= 1);
+    CHECK(differing < pairs / 50);
+}
+
 }
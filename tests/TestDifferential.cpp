@@ -0,0 +1,389 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+ * Differential tests.
+ *
+ * A reference setup and an alternative one, which must produce
+ * the same output, play a generated tune side by side.
+ * The tune writes a pseudo random stream of values to random
+ * SID registers, mixed with the oscillator 3 readings, so that
+ * any divergence in the CPU, the scheduler or the SID emulation
+ * shows up in the register state or in the output.
+ * Both are compared after each block, CPU and SID registers
+ * included, and the first divergence is reported.
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidAllocator.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidInfo.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace UnitTest;
+
+/// Comparison block, 40 ms at 44.1 kHz
+#define BLOCK_FRAMES 1764
+
+/// Compared blocks, 4 seconds
+#define BLOCKS 100
+
+SUITE(Differential)
+{
+
+/*
+ * init ($1000):
+ *     LDA #$A5 : STA $1100  ; random seed
+ *     LDA #$0F : STA $D418
+ *     RTS
+ *
+ * play ($1020):
+ *     LDX #$10              ; 16 writes per frame
+ * loop:
+ *     LDA $1100 : ASL : BCC +2 : EOR #$1D : STA $1100
+ *     AND #$1F : CMP #$19 : BCS next
+ *     TAY                   ; writable register
+ *     LDA $1100 : ASL : BCC +2 : EOR #$1D : STA $1100
+ *     EOR $D41B             ; mix in OSC3
+ *     STA $D400,Y
+ *     STA $D420,Y           ; second SID, if any
+ * next:
+ *     DEX : BNE loop
+ *     RTS
+ */
+const uint8_t initCode[] =
+{
+    0xA9, 0xA5, 0x8D, 0x00, 0x11,
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0x60
+};
+
+const uint8_t playCode[] =
+{
+    0xA2, 0x10,
+    0xAD, 0x00, 0x11, 0x0A, 0x90, 0x02, 0x49, 0x1D, 0x8D, 0x00, 0x11,
+    0x29, 0x1F, 0xC9, 0x19, 0xB0, 0x15,
+    0xA8,
+    0xAD, 0x00, 0x11, 0x0A, 0x90, 0x02, 0x49, 0x1D, 0x8D, 0x00, 0x11,
+    0x4D, 0x1B, 0xD4,
+    0x99, 0x00, 0xD4,
+    0x99, 0x20, 0xD4,
+    0xCA, 0xD0, 0xD7,
+    0x60
+};
+
+std::vector<uint8_t> randomTune(unsigned int sids)
+{
+    return makeTune(initCode, sizeof(initCode), playCode, sizeof(playCode), 1, sids);
+}
+
+const char* const cpuRegs[] = { "PCL", "PCH", "A", "X", "Y", "SP", "P" };
+
+/**
+ * Play the same block on both engines, each in its own chunks,
+ * and compare the output, the CPU and the SID registers.
+ * The samples may differ by the given tolerance.
+ */
+bool compare(sidplayfp &ref, sidplayfp &alt, unsigned int sids,
+             uint_least32_t refChunk, uint_least32_t altChunk,
+             int tolerance = 0)
+{
+    const unsigned int channels = ref.info().channels();
+    const uint_least32_t blockSize = BLOCK_FRAMES * channels;
+
+    std::vector<short> refBuf(blockSize);
+    std::vector<short> altBuf(blockSize);
+
+    for (unsigned int block = 0; block < BLOCKS; block++)
+    {
+        for (uint_least32_t pos = 0; pos < blockSize; pos += refChunk * channels)
+        {
+            if (ref.play(&refBuf[pos], refChunk * channels) != refChunk * channels)
+            {
+                std::cerr << "reference failed: " << ref.error() << std::endl;
+                return false;
+            }
+        }
+
+        for (uint_least32_t pos = 0; pos < blockSize; pos += altChunk * channels)
+        {
+            if (alt.play(&altBuf[pos], altChunk * channels) != altChunk * channels)
+            {
+                std::cerr << "alternative failed: " << alt.error() << std::endl;
+                return false;
+            }
+        }
+
+        uint8_t refCpu[7];
+        uint8_t altCpu[7];
+        ref.getCpuStatus(refCpu);
+        alt.getCpuStatus(altCpu);
+
+        for (unsigned int reg = 0; reg < 7; reg++)
+        {
+            if (refCpu[reg] != altCpu[reg])
+            {
+                std::cerr << "first divergence at block " << block
+                    << ", CPU register " << cpuRegs[reg]
+                    << ": " << int(refCpu[reg]) << " != " << int(altCpu[reg]) << std::endl;
+                return false;
+            }
+        }
+
+        for (unsigned int sid = 0; sid < sids; sid++)
+        {
+            uint8_t refRegs[32];
+            uint8_t altRegs[32];
+            ref.getSidStatus(sid, refRegs);
+            alt.getSidStatus(sid, altRegs);
+
+            for (unsigned int reg = 0; reg < 32; reg++)
+            {
+                if (refRegs[reg] != altRegs[reg])
+                {
+                    std::cerr << "first divergence at block " << block
+                        << ", SID " << sid << " register " << reg
+                        << ": " << int(refRegs[reg]) << " != " << int(altRegs[reg]) << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        for (uint_least32_t i = 0; i < blockSize; i++)
+        {
+            if (std::abs(refBuf[i] - altBuf[i]) > tolerance)
+            {
+                std::cerr << "first divergence at block " << block
+                    << ", sample " << i
+                    << ": " << refBuf[i] << " != " << altBuf[i] << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+TEST(TestChunkSize)
+{
+    ReSIDfpBuilder rs("ReSIDfp");
+    rs.create(2);
+
+    std::vector<uint8_t> data = randomTune(1);
+    SidTune tune(&data[0], data.size());
+    CHECK(tune.getStatus());
+
+    const SidConfig cfg = makeConfig(&rs);
+
+    sidplayfp ref;
+    CHECK(ref.config(cfg));
+    CHECK(ref.load(&tune));
+
+    sidplayfp alt;
+    CHECK(alt.config(cfg));
+    CHECK(alt.load(&tune));
+
+    // A whole block against the shortest allowed chunks
+    CHECK(compare(ref, alt, 1, BLOCK_FRAMES, BLOCK_FRAMES / 7));
+}
+
+TEST(TestClone)
+{
+    ReSIDfpBuilder rs("ReSIDfp");
+    rs.create(4);
+
+    std::vector<uint8_t> data = randomTune(2);
+    SidTune tune(&data[0], data.size());
+    CHECK(tune.getStatus());
+
+    SidConfig cfg = makeConfig(&rs);
+    cfg.playback = SidConfig::STEREO;
+
+    sidplayfp ref;
+    CHECK(ref.config(cfg));
+    CHECK(ref.load(&tune));
+
+    sidplayfp *alt = ref.clone();
+    CHECK(alt != nullptr);
+
+    if (alt != nullptr)
+    {
+        CHECK(compare(ref, *alt, 2, BLOCK_FRAMES, BLOCK_FRAMES));
+        delete alt;
+    }
+}
+
+TEST(TestSharedResampler)
+{
+    ReSIDfpBuilder rs("ReSIDfp");
+    rs.create(4);
+
+    std::vector<uint8_t> data = randomTune(2);
+    SidTune tune(&data[0], data.size());
+    CHECK(tune.getStatus());
+
+    // Mono, so that both chips are mixed into the same resampler
+    SidConfig cfg = makeConfig(&rs);
+
+    sidplayfp ref;
+    CHECK(ref.config(cfg));
+    CHECK(ref.load(&tune));
+
+    cfg.sharedResampler = true;
+
+    sidplayfp alt;
+    CHECK(alt.config(cfg));
+    CHECK(alt.load(&tune));
+
+    // The integer high-pass of the external filter leaves a small
+    // residue, which differs when it runs once on the mixed chips
+    CHECK(compare(ref, alt, 2, BLOCK_FRAMES, BLOCK_FRAMES, 8));
+}
+
+TEST(TestSharedResamplerOff)
+{
+    ReSIDfpBuilder rs("ReSIDfp");
+    rs.create(4);
+
+    std::vector<uint8_t> data = randomTune(2);
+    SidTune tune(&data[0], data.size());
+    CHECK(tune.getStatus());
+
+    SidConfig cfg = makeConfig(&rs);
+
+    sidplayfp ref;
+    CHECK(ref.config(cfg));
+    CHECK(ref.load(&tune));
+
+    // Play shared for a while, then turn it off,
+    // the song restarts with a resampler per chip
+    cfg.sharedResampler = true;
+
+    sidplayfp alt;
+    CHECK(alt.config(cfg));
+    CHECK(alt.load(&tune));
+    std::vector<short> buffer(BLOCK_FRAMES * 10);
+    CHECK_EQUAL(buffer.size(), alt.play(&buffer[0], buffer.size()));
+
+    cfg.sharedResampler = false;
+    CHECK(alt.config(cfg));
+
+    CHECK(compare(ref, alt, 2, BLOCK_FRAMES, BLOCK_FRAMES));
+}
+
+TEST(TestReload)
+{
+    ReSIDfpBuilder rs("ReSIDfp");
+    rs.create(2);
+
+    std::vector<uint8_t> data = randomTune(1);
+    SidTune tune(&data[0], data.size());
+    CHECK(tune.getStatus());
+
+    const SidConfig cfg = makeConfig(&rs);
+
+    // Leave some state behind before restarting the song
+    sidplayfp alt;
+    CHECK(alt.config(cfg));
+    CHECK(alt.load(&tune));
+    std::vector<short> buffer(BLOCK_FRAMES * 10);
+    CHECK_EQUAL(buffer.size(), alt.play(&buffer[0], buffer.size()));
+    CHECK(alt.load(&tune));
+
+    sidplayfp ref;
+    CHECK(ref.config(cfg));
+    CHECK(ref.load(&tune));
+
+    CHECK(compare(ref, alt, 1, BLOCK_FRAMES, BLOCK_FRAMES));
+}
+
+TEST(TestAllocator)
+{
+    struct arena
+    {
+        unsigned int live;
+        unsigned int total;
+
+        static void* allocate(size_t size, void *context)
+        {
+            arena *a = static_cast<arena*>(context);
+            a->live++;
+            a->total++;
+            return malloc(size);
+        }
+
+        static void release(void *ptr, void *context)
+        {
+            static_cast<arena*>(context)->live--;
+            free(ptr);
+        }
+    };
+
+    arena a = { 0, 0 };
+    const SidAllocator allocator(arena::allocate, arena::release, &a);
+
+    {
+        ReSIDfpBuilder rs("ReSIDfp", &allocator);
+        rs.create(6);
+
+        std::vector<uint8_t> data = randomTune(2);
+        SidTune tune(&data[0], data.size());
+        CHECK(tune.getStatus());
+
+        SidConfig cfg = makeConfig(&rs);
+        cfg.playback = SidConfig::STEREO;
+        cfg.sharedResampler = true;
+
+        sidplayfp ref;
+        CHECK(ref.config(cfg));
+        CHECK(ref.load(&tune));
+
+        // The engine state and the SIDs come from the arena
+        sidplayfp alt(&allocator);
+        CHECK(alt.config(cfg));
+        CHECK(alt.load(&tune));
+        CHECK(a.live > 0);
+
+        sidplayfp *clone = alt.clone();
+        CHECK(clone != nullptr);
+        delete clone;
+
+        // The integer high-pass of the external filter leaves a small
+    // residue, which differs when it runs once on the mixed chips
+    CHECK(compare(ref, alt, 2, BLOCK_FRAMES, BLOCK_FRAMES, 8));
+    }
+
+    // Everything has been given back
+    CHECK(a.total > 0);
+    CHECK_EQUAL(0U, a.live);
+}
+
+}
@@ -24,9 +24,11 @@
 #include "../src/sidplayfp/SidTune.h"
 #include "../src/sidplayfp/SidTuneInfo.h"
 #include "../src/sidtune/MUS.h"
+#include "../src/utils/SidDatabase.h"
 
 #include <stdint.h>
 #include <cstring>
+#include <vector>
 
 #define BUFFERSIZE 26
 
@@ -79,4 +81,17 @@ TEST_FIXTURE(TestFixture, TestWrongVoiceLength)
     CHECK_EQUAL("SIDTUNE ERROR: Could not determine file format", tune.statusString());
 }
 
+TEST_FIXTURE(TestFixture, TestNoLength)
+{
+    SidTune tune(data, BUFFERSIZE);
+    CHECK(tune.getStatus());
+    tune.selectSong(0);
+
+    // MUS tunes have no MD5 to look up
+    std::vector<SidTune*> tunes(1, &tune);
+    SidDatabase database;
+    CHECK_EQUAL(-1, database.lengthMs(tunes)[0]);
+    CHECK_EQUAL("SID DATABASE ERROR: Unable to compute the tune MD5.", database.error());
+}
+
 }
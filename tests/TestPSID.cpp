@@ -23,6 +23,7 @@
 
 #include "../src/sidplayfp/SidTune.h"
 #include "../src/sidplayfp/SidTuneInfo.h"
+#include "../src/sidplayfp/SidTuneHeader.h"
 
 #include <stdint.h>
 #include <cstring>
@@ -347,3 +348,81 @@ TEST_FIXTURE(TestFixture, TestWrongThirdSIDAddressLikeSecond)
 }
 
 }
+
+SUITE(SidTuneHeader)
+{
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() { memcpy(data, bufferRSID, BUFFERSIZE); }
+
+    uint8_t data[BUFFERSIZE];
+};
+
+/*
+ * Check that the decoded fields match the full loader.
+ */
+TEST_FIXTURE(TestFixture, TestHeaderMatchesTune)
+{
+    data[VERSION_LO] = 0x04;
+    data[FLAGS] = 0x24; // PAL, 8580
+    data[SECONDSIDADDRESS] = 0x42;
+    data[THIRDSIDADDRESS] = 0x50;
+    memcpy(&data[22], "Title", 5);
+
+    SidTuneHeader header;
+    CHECK(header.read(data, BUFFERSIZE));
+
+    SidTune tune(data, BUFFERSIZE);
+    const SidTuneInfo* info = tune.getInfo(1);
+
+    CHECK_EQUAL(4, header.version());
+    CHECK_EQUAL(info->formatString(), header.formatString());
+    CHECK_EQUAL(info->compatibility(), header.compatibility());
+    CHECK_EQUAL(info->clockSpeed(), header.clockSpeed());
+    CHECK_EQUAL(info->sidChips(), (int)header.sidChips());
+    CHECK_EQUAL(info->sidChipBase(2), header.sidChipBase(2));
+    CHECK_EQUAL(info->sidModel(0), header.sidModel(0));
+    CHECK_EQUAL(info->songSpeed(), header.songSpeed(1));
+    CHECK_EQUAL("Title", header.infoString(0));
+}
+
+/*
+ * A full length info string is terminated.
+ */
+TEST_FIXTURE(TestFixture, TestInfoStringFullLength)
+{
+    memset(&data[54], 'A', 32);
+
+    SidTuneHeader header;
+    CHECK(header.read(data, BUFFERSIZE));
+
+    CHECK_EQUAL(32, (int)strlen(header.infoString(1)));
+}
+
+/*
+ * Errors are reported like the full loader.
+ */
+TEST_FIXTURE(TestFixture, TestUnsupportedVersion)
+{
+    data[VERSION_LO] = 0x01;
+
+    SidTuneHeader header;
+    CHECK(!header.read(data, BUFFERSIZE));
+
+    CHECK_EQUAL("Unsupported RSID version", header.statusString());
+}
+
+/*
+ * Input shorter than the header is rejected.
+ */
+TEST_FIXTURE(TestFixture, TestTruncated)
+{
+    SidTuneHeader header;
+    CHECK(!header.read(data, 100));
+
+    CHECK_EQUAL("SIDTUNE ERROR: File is most likely truncated", header.statusString());
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidProbe.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace UnitTest;
+
+SUITE(Probe)
+{
+
+/*
+ * play ($1020), called on every PAL frame:
+ *     LDA #$21 : STA $D404
+ *     RTS
+ */
+const uint8_t playCode[] =
+{
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0x60
+};
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        rs("ReSIDfp"),
+        data(makeTune(nullptr, 0, playCode, sizeof(playCode))),
+        tune(&data[0], data.size()),
+        cfg(makeConfig(&rs))
+    {
+        rs.create(2);
+
+        // A second chip the tune never writes to
+        cfg.secondSidAddress = 0xd420;
+
+        tune.selectSong(0);
+        engine.config(cfg);
+        engine.load(&tune);
+    }
+
+    ReSIDfpBuilder rs;
+    std::vector<uint8_t> data;
+    SidTune tune;
+    SidConfig cfg;
+    sidplayfp engine;
+};
+
+TEST_FIXTURE(TestFixture, TestVbiTune)
+{
+    SidProbe result;
+    CHECK(engine.probe(5000, result));
+
+    CHECK(result.timeMs >= 5000);
+
+    // One raster interrupt per PAL frame, 985248 / 19656 Hz,
+    // less the frames before the tune starts
+    CHECK_CLOSE(50.125, result.irqRate, 0.5);
+    CHECK_EQUAL(0., result.nmiRate);
+
+    CHECK_EQUAL(2U, result.sidChips);
+    CHECK_EQUAL(1U, result.sidChipsUsed);
+    CHECK_CLOSE(result.irqRate, result.sidWriteRate, 0.5);
+
+    // The tune waits in the driver between the play calls
+    CHECK(result.idleCycles > 0);
+    CHECK(result.idleCycles < result.cpuCycles);
+
+    // Restarted
+    CHECK_EQUAL(0U, engine.timeMs());
+}
+
+TEST_FIXTURE(TestFixture, TestNoTune)
+{
+    sidplayfp empty;
+    SidProbe result;
+    CHECK(!empty.probe(100, result));
+}
+
+}
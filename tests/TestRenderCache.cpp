@@ -0,0 +1,270 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidInfo.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+#include "../src/utils/SidRenderCache.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace UnitTest;
+
+/// Rendered duration
+#define MS 500
+
+SUITE(RenderCache)
+{
+
+/*
+ * init ($1000):
+ *     ORA #$10 : STA $D401  ; frequency from the song number
+ *     LDA #$0F : STA $D418
+ *     LDA #$00 : STA $D405
+ *     LDA #$F0 : STA $D406
+ *     LDA #$21 : STA $D404  ; sawtooth, gate on
+ *     RTS
+ *
+ * play ($1020):
+ *     RTS
+ */
+const uint8_t initCode[] =
+{
+    0x09, 0x10, 0x8D, 0x01, 0xD4,
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0xA9, 0x00, 0x8D, 0x05, 0xD4,
+    0xA9, 0xF0, 0x8D, 0x06, 0xD4,
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0x60
+};
+
+uint_least64_t fnv(const std::vector<short> &pcm)
+{
+    uint_least64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < pcm.size(); i++)
+    {
+        const unsigned int sample = static_cast<uint16_t>(pcm[i]);
+        hash ^= sample & 0xff;
+        hash *= 0x100000001b3ULL;
+        hash ^= sample >> 8;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        rs("ReSIDfp"),
+        data(makeTune(initCode, sizeof(initCode), nullptr, 0, 2)),
+        tune(&data[0], data.size()),
+        cfg(makeConfig(&rs))
+    {
+        rs.create(2);
+    }
+
+    ReSIDfpBuilder rs;
+    std::vector<uint8_t> data;
+    SidTune tune;
+    SidConfig cfg;
+};
+
+TEST(TestConfigHash)
+{
+    SidConfig a;
+    SidConfig b;
+    CHECK_EQUAL(a.hash(), b.hash());
+
+    b.seed = 1;
+    CHECK(a.hash() != b.hash());
+
+    b = a;
+    b.frequency = 48000;
+    CHECK(a.hash() != b.hash());
+
+    b = a;
+    b.forceSidModel = true;
+    CHECK(a.hash() != b.hash());
+}
+
+TEST_FIXTURE(TestFixture, TestSeededDeterminism)
+{
+    sidplayfp a;
+    CHECK(a.config(cfg));
+    CHECK(a.load(&tune));
+
+    sidplayfp b;
+    CHECK(b.config(cfg));
+    CHECK(b.load(&tune));
+
+    std::vector<short> bufA(44100);
+    std::vector<short> bufB(44100);
+    CHECK_EQUAL(bufA.size(), a.play(&bufA[0], bufA.size()));
+    CHECK_EQUAL(bufB.size(), b.play(&bufB[0], bufB.size()));
+
+    CHECK(bufA == bufB);
+    CHECK(bufA != std::vector<short>(bufA.size(), bufA[0]));
+}
+
+TEST_FIXTURE(TestFixture, TestNoSeed)
+{
+    cfg.seed = 0;
+
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+
+    SidRenderCache cache(1 << 20);
+    std::vector<short> pcm;
+    CHECK(!cache.render(engine, tune, 0, MS, pcm));
+    CHECK_EQUAL(0U, cache.misses());
+}
+
+TEST_FIXTURE(TestFixture, TestHit)
+{
+    SidRenderCache cache(1 << 20);
+
+    sidplayfp a;
+    CHECK(a.config(cfg));
+    std::vector<short> pcmA;
+    CHECK(cache.render(a, tune, 0, MS, pcmA));
+    CHECK_EQUAL(0U, cache.hits());
+    CHECK_EQUAL(1U, cache.misses());
+    CHECK_EQUAL(pcmA.size() * sizeof(short), cache.size());
+
+    // Another engine with the same setup is served from the cache
+    sidplayfp b;
+    CHECK(b.config(cfg));
+    std::vector<short> pcmB;
+    CHECK(cache.render(b, tune, 1, MS, pcmB));
+    CHECK_EQUAL(1U, cache.hits());
+    CHECK(pcmA == pcmB);
+
+    uint_least64_t sum;
+    CHECK(cache.checksum(b, tune, 1, MS, sum));
+    CHECK_EQUAL(2U, cache.hits());
+    CHECK_EQUAL(fnv(pcmA), sum);
+
+    // Another song
+    CHECK(cache.render(b, tune, 2, MS, pcmB));
+    CHECK_EQUAL(2U, cache.misses());
+    CHECK(pcmA != pcmB);
+
+    cache.clear();
+    CHECK_EQUAL(0U, cache.size());
+}
+
+TEST_FIXTURE(TestFixture, TestRoms)
+{
+    SidRenderCache cache(1 << 20);
+
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    std::vector<short> pcm;
+    CHECK(cache.render(engine, tune, 0, MS, pcm));
+
+    // A different BASIC does not change this output but must not be shared
+    const uint_least64_t digest = engine.info().romDigest();
+    std::vector<uint8_t> basic(0x2000, 0);
+    engine.setBasic(&basic[0]);
+    CHECK(engine.info().romDigest() != digest);
+
+    CHECK(cache.render(engine, tune, 0, MS, pcm));
+    CHECK_EQUAL(0U, cache.hits());
+    CHECK_EQUAL(2U, cache.misses());
+}
+
+TEST_FIXTURE(TestFixture, TestBuilderSettings)
+{
+    SidRenderCache cache(1 << 20);
+
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    std::vector<short> pcmA;
+    CHECK(cache.render(engine, tune, 0, MS, pcmA));
+
+    // The filter curve is set on the builder, not in the configuration
+    rs.filter6581Curve(0.9);
+    CHECK(engine.config(cfg));
+    std::vector<short> pcmB;
+    CHECK(cache.render(engine, tune, 0, MS, pcmB));
+    CHECK_EQUAL(0U, cache.hits());
+    CHECK_EQUAL(2U, cache.misses());
+
+    rs.filter(false);
+    CHECK(cache.render(engine, tune, 0, MS, pcmB));
+    CHECK_EQUAL(0U, cache.hits());
+    CHECK_EQUAL(3U, cache.misses());
+}
+
+TEST_FIXTURE(TestFixture, TestMuted)
+{
+    SidRenderCache cache(1 << 20);
+
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    std::vector<short> pcmA;
+    CHECK(cache.render(engine, tune, 0, MS, pcmA));
+
+    engine.mute(0, 0, true);
+    CHECK(engine.isMuted(0, 0));
+    std::vector<short> pcmB;
+    CHECK(cache.render(engine, tune, 0, MS, pcmB));
+    CHECK_EQUAL(0U, cache.hits());
+    CHECK_EQUAL(2U, cache.misses());
+    CHECK(pcmA != pcmB);
+
+    engine.mute(0, 0, false);
+    CHECK(!engine.isMuted(0, 0));
+    CHECK(cache.render(engine, tune, 0, MS, pcmB));
+    CHECK_EQUAL(1U, cache.hits());
+    CHECK(pcmA == pcmB);
+}
+
+TEST_FIXTURE(TestFixture, TestBudget)
+{
+    // Too small for the samples
+    SidRenderCache cache(1024);
+
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    std::vector<short> pcm;
+    CHECK(cache.render(engine, tune, 0, MS, pcm));
+    CHECK_EQUAL(0U, cache.size());
+
+    // The checksum is kept anyway
+    uint_least64_t sum;
+    CHECK(cache.checksum(engine, tune, 0, MS, sum));
+    CHECK_EQUAL(1U, cache.hits());
+    CHECK_EQUAL(fnv(pcm), sum);
+
+    CHECK(cache.render(engine, tune, 0, MS, pcm));
+    CHECK_EQUAL(2U, cache.misses());
+}
+
+}
@@ -0,0 +1,163 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidWrite.h"
+#include "../src/builders/residfp-builder/residfp.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace UnitTest;
+
+/// One second of PAL cycles
+#define SECOND 985248
+
+SUITE(Replay)
+{
+
+/// A sawtooth held for a second, much longer than the chip buffer
+const SidWrite logWrites[] =
+{
+    {  0, 0x18, 0x0f },
+    { 10, 0x01, 0x10 },
+    { 10, 0x06, 0xf0 },
+    { 10, 0x04, 0x21 },
+    { SECOND, 0x04, 0x20 },
+};
+
+const unsigned int logSize = sizeof(logWrites) / sizeof(logWrites[0]);
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        rs("ReSIDfp"),
+        data(makeTune(nullptr, 0, nullptr, 0)),
+        tune(&data[0], data.size()),
+        cfg(makeConfig(&rs))
+    {
+        rs.create(2);
+    }
+
+    /// Replay the whole log in calls of the given size
+    std::vector<short> replay(sidplayfp &engine, uint_least32_t chunk)
+    {
+        std::vector<short> out;
+        std::vector<short> buffer(chunk);
+        unsigned int pos = 0;
+        for (;;)
+        {
+            unsigned int applied;
+            const uint_least32_t n = engine.replay(logWrites + pos, logSize - pos, &buffer[0], chunk, applied);
+            out.insert(out.end(), buffer.begin(), buffer.begin() + n);
+            pos += applied;
+
+            // Until the pending samples are drained
+            if ((pos == logSize) && (n < chunk))
+                break;
+            if ((n == 0) && (applied == 0))
+                break;
+        }
+        return out;
+    }
+
+    ReSIDfpBuilder rs;
+    std::vector<uint8_t> data;
+    SidTune tune;
+    SidConfig cfg;
+};
+
+TEST_FIXTURE(TestFixture, TestLongBatch)
+{
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+
+    // The second of output is mixed through small buffers
+    const std::vector<short> out = replay(engine, 4410);
+    CHECK(out.size() > 44100U);
+    CHECK(out.size() < 44120U);
+    CHECK(out != std::vector<short>(out.size(), out[0]));
+
+    uint8_t regs[32];
+    CHECK(engine.getSidStatus(0, regs));
+    CHECK_EQUAL(0x20, regs[4]);
+    CHECK_EQUAL(0x0f, regs[0x18]);
+}
+
+TEST_FIXTURE(TestFixture, TestSplit)
+{
+    sidplayfp a;
+    CHECK(a.config(cfg));
+    CHECK(a.load(&tune));
+
+    sidplayfp b;
+    CHECK(b.config(cfg));
+    CHECK(b.load(&tune));
+
+    // The output does not depend on where the calls stop
+    CHECK(replay(a, 44100) == replay(b, 441));
+}
+
+TEST_FIXTURE(TestFixture, TestRestart)
+{
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+
+    std::vector<short> buffer(4410);
+    unsigned int applied;
+    engine.replay(logWrites, logSize, &buffer[0], buffer.size(), applied);
+    CHECK(applied < logSize);
+
+    // The tune restarts, as after a stop, and plays again
+    engine.play(&buffer[0], buffer.size());
+    CHECK_EQUAL(0U, engine.timeMs());
+    CHECK_EQUAL(buffer.size(), engine.play(&buffer[0], buffer.size()));
+    CHECK(engine.isPlaying());
+}
+
+TEST_FIXTURE(TestFixture, TestErrors)
+{
+    sidplayfp engine;
+    CHECK(engine.config(cfg));
+
+    std::vector<short> buffer(4410);
+    unsigned int applied;
+    CHECK_EQUAL(0U, engine.replay(logWrites, logSize, &buffer[0], buffer.size(), applied));
+    CHECK_EQUAL(0U, applied);
+
+    // Two SIDs
+    cfg.secondSidAddress = 0xd420;
+    CHECK(engine.config(cfg));
+    CHECK(engine.load(&tune));
+    CHECK_EQUAL(0U, engine.replay(logWrites, logSize, &buffer[0], buffer.size(), applied));
+    CHECK_EQUAL(0U, applied);
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/builders/residfp-builder/residfp/resample/SincResampler.cpp"
+#include "../src/builders/residfp-builder/residfp/resample/CicResampler.h"
+#include "../src/builders/residfp-builder/residfp/resample/TwoPassSincResampler.h"
+
+#include <cmath>
+#include <memory>
+
+#include "sidcxx11.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+#define CLOCK 985248.
+#define RATE 44100.
+
+SUITE(Resampler)
+{
+
+/**
+ * Play a tone through the resampler.
+ *
+ * @return the output level relative to the input, in dB
+ */
+double level(Resampler &r, double frequency)
+{
+    const double amplitude = 10000.;
+    const double omega = 2. * M_PI * frequency / CLOCK;
+
+    r.reset();
+
+    // Skip the first outputs, while the filters settle
+    int outputs = 0;
+    double sum = 0.;
+    int n = 0;
+    for (int k = 0; k < CLOCK / 5; k++)
+    {
+        const int sample = static_cast<int>(std::floor(amplitude * sin(omega * k) + 0.5));
+        if (r.input(sample) && ++outputs > 1000)
+        {
+            const double value = r.getOutput();
+            sum += value * value;
+            n++;
+        }
+    }
+
+    return 20. * log10(sqrt(sum / n) / (amplitude / sqrt(2.)));
+}
+
+TEST(TestCicPassband)
+{
+    std::unique_ptr<CicResampler> cic(CicResampler::create(CLOCK, RATE, 20000.));
+    std::unique_ptr<TwoPassSincResampler> sinc(TwoPassSincResampler::create(CLOCK, RATE, 20000.));
+
+    // As the two pass sinc, apart from the CIC droop
+    CHECK_CLOSE(level(*sinc, 1000.), level(*cic, 1000.), 0.1);
+    CHECK_CLOSE(level(*sinc, 10000.), level(*cic, 10000.), 0.5);
+}
+
+TEST(TestCicImages)
+{
+    std::unique_ptr<CicResampler> cic(CicResampler::create(CLOCK, RATE, 20000.));
+
+    // Tones folding into the passband, 120 kHz is the worst measured
+    CHECK(level(*cic, 40000.) < -60.);
+    CHECK(level(*cic, 120000.) < -60.);
+    CHECK(level(*cic, 300000.) < -60.);
+}
+
+}
@@ -0,0 +1,203 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/builders/residfp-builder/residfp.h"
+#include "../src/utils/SidScheduler.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <vector>
+
+#if __cplusplus >= 201103L
+#  include <atomic>
+#  include <thread>
+#endif
+
+using namespace UnitTest;
+
+/// 100 ms at 44.1 kHz mono
+#define BUFFER 4410U
+
+/// 20 ms at 44.1 kHz mono
+#define QUANTUM 882U
+
+SUITE(Scheduler)
+{
+
+/*
+ * init ($1000):
+ *     LDA #$0F : STA $D418
+ *     LDA #$F0 : STA $D406
+ *     LDA #$11 : STA $D401
+ *     LDA #$21 : STA $D404  ; sawtooth, gate on
+ *     RTS
+ *
+ * play ($1020):
+ *     RTS
+ */
+const uint8_t initCode[] =
+{
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0xA9, 0xF0, 0x8D, 0x06, 0xD4,
+    0xA9, 0x11, 0x8D, 0x01, 0xD4,
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0x60
+};
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        rs("ReSIDfp"),
+        data(makeTune(initCode, sizeof(initCode), nullptr, 0)),
+        tune(&data[0], data.size()),
+        scheduler(100, 20)
+    {
+        rs.create(ENGINES);
+
+        const SidConfig cfg = makeConfig(&rs);
+
+        for (int i = 0; i < ENGINES; i++)
+        {
+            engines[i].config(cfg);
+            engines[i].load(&tune);
+        }
+    }
+
+    static const int ENGINES = 3;
+
+    ReSIDfpBuilder rs;
+    std::vector<uint8_t> data;
+    SidTune tune;
+    sidplayfp engines[ENGINES];
+    SidScheduler scheduler;
+};
+
+TEST_FIXTURE(TestFixture, TestRounds)
+{
+    const unsigned int a = scheduler.addStream(&engines[0]);
+    const unsigned int b = scheduler.addStream(&engines[1]);
+    CHECK(a != b);
+
+    // One quantum per stream and round
+    CHECK_EQUAL(2U, scheduler.run());
+    CHECK_EQUAL(QUANTUM, scheduler.available(a));
+    CHECK_EQUAL(QUANTUM, scheduler.available(b));
+
+    // Until the buffers are full
+    while (scheduler.run() != 0) {}
+    CHECK_EQUAL(BUFFER, scheduler.available(a));
+    CHECK_EQUAL(BUFFER, scheduler.available(b));
+
+    // Reading makes room for the next quantum
+    std::vector<short> buffer(QUANTUM);
+    CHECK_EQUAL(QUANTUM, scheduler.read(a, &buffer[0], QUANTUM));
+    CHECK_EQUAL(BUFFER - QUANTUM, scheduler.available(a));
+    CHECK_EQUAL(1U, scheduler.run());
+    CHECK_EQUAL(BUFFER, scheduler.available(a));
+
+    CHECK(!scheduler.stopped(a));
+}
+
+TEST_FIXTURE(TestFixture, TestRefill)
+{
+    const unsigned int a = scheduler.addStream(&engines[0]);
+    const unsigned int b = scheduler.addStream(&engines[1]);
+    while (scheduler.run() != 0) {}
+
+    // Every stream with room gets a single quantum per round
+    scheduler.setThreads(1);
+    std::vector<short> buffer(BUFFER);
+    scheduler.read(b, &buffer[0], BUFFER);
+    scheduler.read(a, &buffer[0], QUANTUM);
+    CHECK_EQUAL(2U, scheduler.run());
+    CHECK_EQUAL(BUFFER, scheduler.available(a));
+    CHECK_EQUAL(QUANTUM, scheduler.available(b));
+}
+
+TEST_FIXTURE(TestFixture, TestRemove)
+{
+    const unsigned int a = scheduler.addStream(&engines[0]);
+    const unsigned int b = scheduler.addStream(&engines[1]);
+    scheduler.run();
+
+    scheduler.removeStream(a);
+    CHECK_EQUAL(0U, scheduler.available(a));
+    CHECK(scheduler.stopped(a));
+
+    short sample;
+    CHECK_EQUAL(0U, scheduler.read(a, &sample, 1));
+
+    // Only the remaining stream is rendered
+    CHECK_EQUAL(1U, scheduler.run());
+    CHECK_EQUAL(2U * QUANTUM, scheduler.available(b));
+
+    // The slot is reused
+    CHECK_EQUAL(a, scheduler.addStream(&engines[2]));
+    CHECK_EQUAL(0U, scheduler.available(a));
+}
+
+#if __cplusplus >= 201103L
+TEST_FIXTURE(TestFixture, TestConcurrentRead)
+{
+    std::atomic<bool> done(false);
+
+    // Read all the possible ids while the table changes
+    std::thread reader([&]()
+    {
+        std::vector<short> buffer(QUANTUM);
+        while (!done)
+        {
+            for (unsigned int id = 0; id < ENGINES; id++)
+            {
+                scheduler.available(id);
+                scheduler.stopped(id);
+                scheduler.read(id, &buffer[0], QUANTUM / 2);
+            }
+        }
+    });
+
+    for (int i = 0; i < 200; i++)
+    {
+        const unsigned int a = scheduler.addStream(&engines[0]);
+        const unsigned int b = scheduler.addStream(&engines[1]);
+        scheduler.run();
+        scheduler.removeStream(a);
+        const unsigned int c = scheduler.addStream(&engines[2]);
+        scheduler.run();
+        scheduler.removeStream(b);
+        scheduler.removeStream(c);
+    }
+
+    done = true;
+    reader.join();
+
+    CHECK_EQUAL(0U, scheduler.available(0));
+}
+#endif
+
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/utils/SidDatabase.h"
+
+#include "TestTune.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace UnitTest;
+
+#define DATABASE "TestSidDatabase.md5"
+
+#define MD5_A "0123456789abcdef0123456789abcdef"
+#define MD5_B "fedcba9876543210fedcba9876543210"
+#define MD5_MISSING "00000000000000000000000000000000"
+
+SUITE(SidDatabase)
+{
+
+/// RTS and LDA #$00 : RTS, to tell the tunes apart
+const uint8_t rts[] = { 0x60 };
+const uint8_t lda[] = { 0xA9, 0x00, 0x60 };
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        dataA(makeTune(rts, sizeof(rts), nullptr, 0, 2)),
+        dataB(makeTune(lda, sizeof(lda), nullptr, 0)),
+        tuneA(&dataA[0], dataA.size()),
+        tuneB(&dataB[0], dataB.size())
+    {
+        tuneA.selectSong(2);
+        tuneB.selectSong(1);
+
+        char md5[SidTune::MD5_LENGTH + 1];
+        std::string entries =
+            "[Database]\n"
+            "; a comment\n"
+            MD5_A "=0:30 1:15.5 2:00.250\n"
+            MD5_B "=3:00\n";
+        entries += std::string(tuneA.createMD5New(md5)) + "=0:45 0:10\n";
+
+        FILE* f = fopen(DATABASE, "wb");
+        if (f != nullptr)
+        {
+            fwrite(entries.data(), 1, entries.size(), f);
+            fclose(f);
+        }
+    }
+
+    ~TestFixture() { remove(DATABASE); }
+
+    std::vector<uint8_t> dataA;
+    std::vector<uint8_t> dataB;
+    SidTune tuneA;
+    SidTune tuneB;
+    SidDatabase db;
+};
+
+TEST_FIXTURE(TestFixture, TestSongs)
+{
+    CHECK(db.open(DATABASE));
+
+    std::vector<std::pair<const char*, unsigned int> > songs;
+    songs.push_back(std::make_pair(MD5_A, 3u));
+    songs.push_back(std::make_pair(MD5_B, 1u));
+    songs.push_back(std::make_pair(MD5_A, 1u));
+    songs.push_back(std::make_pair(MD5_A, 2u));
+    songs.push_back(std::make_pair(MD5_A, 1u));
+    // Past the end of the entries
+    songs.push_back(std::make_pair(MD5_B, 2u));
+    songs.push_back(std::make_pair(MD5_A, 4u));
+    songs.push_back(std::make_pair(MD5_MISSING, 1u));
+
+    const std::vector<int_least32_t> lengths = db.lengthMs(songs);
+    CHECK_EQUAL(songs.size(), lengths.size());
+
+    for (size_t i = 0; i < songs.size(); i++)
+    {
+        CHECK_EQUAL(db.lengthMs(songs[i].first, songs[i].second), lengths[i]);
+    }
+
+    CHECK_EQUAL(120250, lengths[0]);
+    CHECK_EQUAL(180000, lengths[1]);
+    CHECK_EQUAL(30000, lengths[2]);
+    CHECK_EQUAL(75500, lengths[3]);
+    CHECK_EQUAL(-1, lengths[5]);
+    CHECK_EQUAL(-1, lengths[6]);
+    CHECK_EQUAL(-1, lengths[7]);
+}
+
+TEST_FIXTURE(TestFixture, TestTunes)
+{
+    CHECK(db.open(DATABASE));
+
+    std::vector<SidTune*> tunes;
+    tunes.push_back(&tuneA);
+    tunes.push_back(&tuneB);
+    tunes.push_back(&tuneA);
+
+    const std::vector<int_least32_t> lengths = db.lengthMs(tunes);
+    CHECK_EQUAL(3U, lengths.size());
+
+    CHECK_EQUAL(10000, lengths[0]);
+    CHECK_EQUAL(db.lengthMs(tuneA), lengths[0]);
+    CHECK_EQUAL(-1, lengths[1]);
+    CHECK_EQUAL(db.lengthMs(tuneB), lengths[1]);
+    CHECK_EQUAL(10000, lengths[2]);
+}
+
+TEST_FIXTURE(TestFixture, TestErrorOrder)
+{
+    CHECK(db.open(DATABASE));
+
+    // Not selected
+    SidTune unselected(&dataB[0], dataB.size());
+
+    db.lengthMs(unselected);
+    const std::string noSong = db.error();
+    db.lengthMs(tuneB);
+    const std::string missing = db.error();
+    CHECK(noSong != missing);
+
+    // The error of the last failed tune is reported
+    std::vector<SidTune*> tunes;
+    tunes.push_back(&unselected);
+    tunes.push_back(&tuneB);
+    tunes.push_back(&tuneA);
+
+    db.lengthMs(tunes);
+    CHECK_EQUAL(missing, std::string(db.error()));
+
+    tunes[0] = &tuneB;
+    tunes[1] = &unselected;
+
+    db.lengthMs(tunes);
+    CHECK_EQUAL(noSong, std::string(db.error()));
+}
+
+}
@@ -0,0 +1,345 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidTuneInfo.h"
+#include "../src/sidplayfp/SidTuneArchive.h"
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace UnitTest;
+
+#define TARFILE "TestTarIndex.tar"
+
+uint8_t const bufferRSID[128] = {
+    0x52, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x00, 0x00,             // loadAddress
+    0x00, 0x00,             // initAddress
+    0x00, 0x00,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x00,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    0xe8, 0x07, 0x00, 0x00  // data
+};
+
+uint8_t const bufferMUS[26] =
+{
+    0x52, 0x53,             // load address
+    0x04, 0x00,             // length of the data for Voice 1
+    0x04, 0x00,             // length of the data for Voice 2
+    0x04, 0x00,             // length of the data for Voice 3
+    0x00, 0x00, 0x01, 0x4F, // data for Voice 1
+    0x00, 0x00, 0x01, 0x4F, // data for Voice 2
+    0x00, 0x01, 0x01, 0x4F, // data for Voice 3
+    0x0d, 0x0d, 0x0d, 0x0d, 0x0d, 0x00, // text description
+};
+
+/**
+ * Build a tar archive in memory.
+ */
+class tarBuilder
+{
+private:
+    std::vector<uint8_t> m_data;
+
+private:
+    void octal(uint8_t* field, size_t len, size_t value)
+    {
+        snprintf(reinterpret_cast<char*>(field), len, "%0*o", static_cast<int>(len - 1), static_cast<unsigned int>(value));
+    }
+
+    void header(const char* name, const char* prefix, char type, size_t size)
+    {
+        uint8_t h[512];
+        memset(h, 0, sizeof(h));
+        strncpy(reinterpret_cast<char*>(h), name, 100);
+        octal(h + 100, 8, 0644);
+        octal(h + 108, 8, 0);
+        octal(h + 116, 8, 0);
+        octal(h + 124, 12, size);
+        octal(h + 136, 12, 0);
+        h[156] = type;
+        memcpy(h + 257, "ustar", 6);
+        memcpy(h + 263, "00", 2);
+        if (prefix != nullptr)
+            strncpy(reinterpret_cast<char*>(h + 345), prefix, 155);
+
+        memset(h + 148, ' ', 8);
+        unsigned int sum = 0;
+        for (size_t i = 0; i < sizeof(h); i++)
+            sum += h[i];
+        octal(h + 148, 7, sum);
+
+        m_data.insert(m_data.end(), h, h + sizeof(h));
+    }
+
+    void body(const uint8_t* data, size_t size)
+    {
+        m_data.insert(m_data.end(), data, data + size);
+        m_data.resize((m_data.size() + 511) & ~static_cast<size_t>(511), 0);
+    }
+
+public:
+    void file(const char* name, const uint8_t* data, size_t size, const char* prefix = nullptr)
+    {
+        header(name, prefix, '0', size);
+        body(data, size);
+    }
+
+    void file(const char* name, const char* text)
+    {
+        file(name, reinterpret_cast<const uint8_t*>(text), strlen(text));
+    }
+
+    void dir(const char* name)
+    {
+        header(name, nullptr, '5', 0);
+    }
+
+    void gnuLongName(const char* longName, const char* text)
+    {
+        const size_t len = strlen(longName) + 1;
+        header("././@LongLink", nullptr, 'L', len);
+        body(reinterpret_cast<const uint8_t*>(longName), len);
+        file("truncated", text);
+    }
+
+    void paxPath(const char* path, const char* text)
+    {
+        std::string record = std::string(" path=") + path + "\n";
+        // The length includes its own digits
+        char digits[16];
+        size_t len = record.size();
+        do
+        {
+            len++;
+            snprintf(digits, sizeof(digits), "%u", static_cast<unsigned int>(len));
+        } while (strlen(digits) + record.size() != len);
+        record = digits + record;
+        header("PaxHeaders/truncated", nullptr, 'x', record.size());
+        body(reinterpret_cast<const uint8_t*>(record.data()), record.size());
+        file("truncated", text);
+    }
+
+    void end()
+    {
+        m_data.resize(m_data.size() + 1024, 0);
+    }
+
+    std::vector<uint8_t>& data() { return m_data; }
+
+    bool write(size_t size)
+    {
+        FILE* f = fopen(TARFILE, "wb");
+        if (f == nullptr)
+            return false;
+        const bool ok = fwrite(m_data.data(), 1, size, f) == size;
+        return (fclose(f) == 0) && ok;
+    }
+
+    bool write() { return write(m_data.size()); }
+};
+
+std::string contents(const SidTuneArchive& archive, const char* path)
+{
+    uint_least32_t length;
+    const uint_least8_t* data = archive.find(path, length);
+    return data ? std::string(reinterpret_cast<const char*>(data), length) : std::string("<missing>");
+}
+
+SUITE(TarIndex)
+{
+
+struct TestFixture
+{
+    ~TestFixture() { remove(TARFILE); }
+
+    tarBuilder tar;
+    SidTuneArchive archive;
+};
+
+TEST_FIXTURE(TestFixture, TestUstar)
+{
+    tar.dir("C64Music/");
+    tar.file("C64Music/a.sid", "first");
+    tar.file("b.sid", reinterpret_cast<const uint8_t*>("second"), 6, "C64Music/MUSICIANS");
+    tar.file("./C64Music/empty.sid", "");
+    tar.end();
+    CHECK(tar.write());
+
+    CHECK(archive.open(TARFILE));
+    CHECK_EQUAL(3U, archive.entries());
+    CHECK_EQUAL("C64Music/MUSICIANS/b.sid", archive.path(0));
+    CHECK_EQUAL("C64Music/a.sid", archive.path(1));
+    CHECK_EQUAL("C64Music/empty.sid", archive.path(2));
+
+    CHECK_EQUAL("first", contents(archive, "C64Music/a.sid"));
+    CHECK_EQUAL("first", contents(archive, "/C64Music/a.sid"));
+    CHECK_EQUAL("first", contents(archive, "./C64Music/a.sid"));
+    CHECK_EQUAL("second", contents(archive, "C64Music/MUSICIANS/b.sid"));
+    CHECK_EQUAL("", contents(archive, "C64Music/empty.sid"));
+    CHECK_EQUAL("<missing>", contents(archive, "C64Music"));
+    CHECK_EQUAL("<missing>", contents(archive, "C64Music/c.sid"));
+}
+
+TEST_FIXTURE(TestFixture, TestGnuLongName)
+{
+    const std::string longName = "C64Music/" + std::string(150, 'x') + ".sid";
+    tar.gnuLongName(longName.c_str(), "long");
+    tar.file("short.sid", "short");
+    tar.end();
+    CHECK(tar.write());
+
+    CHECK(archive.open(TARFILE));
+    CHECK_EQUAL(2U, archive.entries());
+    CHECK_EQUAL("long", contents(archive, longName.c_str()));
+    // The long name only applies to the following entry
+    CHECK_EQUAL("short", contents(archive, "short.sid"));
+    CHECK_EQUAL("<missing>", contents(archive, "truncated"));
+}
+
+TEST_FIXTURE(TestFixture, TestPaxPath)
+{
+    const std::string longName = "C64Music/" + std::string(200, 'y') + ".sid";
+    tar.paxPath(longName.c_str(), "pax");
+    tar.end();
+    CHECK(tar.write());
+
+    CHECK(archive.open(TARFILE));
+    CHECK_EQUAL(1U, archive.entries());
+    CHECK_EQUAL(longName, archive.path(0));
+    CHECK_EQUAL("pax", contents(archive, longName.c_str()));
+}
+
+TEST_FIXTURE(TestFixture, TestLastCopyWins)
+{
+    tar.file("a.sid", "old");
+    tar.file("b.sid", "other");
+    tar.file("./a.sid", "new");
+    tar.end();
+    CHECK(tar.write());
+
+    CHECK(archive.open(TARFILE));
+    CHECK_EQUAL(2U, archive.entries());
+    CHECK_EQUAL("new", contents(archive, "a.sid"));
+    CHECK_EQUAL("other", contents(archive, "b.sid"));
+}
+
+TEST_FIXTURE(TestFixture, TestMissingEndBlocks)
+{
+    tar.file("a.sid", "data");
+    CHECK(tar.write());
+
+    CHECK(archive.open(TARFILE));
+    CHECK_EQUAL("data", contents(archive, "a.sid"));
+}
+
+TEST_FIXTURE(TestFixture, TestTruncatedHeader)
+{
+    tar.file("a.sid", "data");
+    tar.file("b.sid", "data");
+    CHECK(tar.write(512 + 512 + 100));
+
+    CHECK(!archive.open(TARFILE));
+    CHECK_EQUAL("Archive is truncated", archive.error());
+    CHECK_EQUAL(0U, archive.entries());
+}
+
+TEST_FIXTURE(TestFixture, TestTruncatedData)
+{
+    tar.file("a.sid", std::string(1000, 'z').c_str());
+    CHECK(tar.write(512 + 600));
+
+    CHECK(!archive.open(TARFILE));
+    CHECK_EQUAL("Archive is truncated", archive.error());
+}
+
+TEST_FIXTURE(TestFixture, TestBadChecksum)
+{
+    tar.file("a.sid", "data");
+    tar.end();
+    tar.data()[0] = 'b';
+    CHECK(tar.write());
+
+    CHECK(!archive.open(TARFILE));
+    CHECK_EQUAL("Not a tar archive", archive.error());
+}
+
+TEST_FIXTURE(TestFixture, TestLoadPSID)
+{
+    tar.file("C64Music/tune.sid", bufferRSID, sizeof(bufferRSID));
+    tar.end();
+    CHECK(tar.write());
+    CHECK(archive.open(TARFILE));
+
+    SidTune tune(nullptr);
+    tune.load(archive, "C64Music/tune.sid");
+    CHECK(tune.getStatus());
+    CHECK_EQUAL(0x07e8, tune.getInfo()->loadAddr());
+
+    tune.load(archive, "C64Music/missing.sid");
+    CHECK(!tune.getStatus());
+}
+
+TEST_FIXTURE(TestFixture, TestLoadMUS)
+{
+    tar.file("C64Music/mono.mus", bufferMUS, sizeof(bufferMUS));
+    tar.file("C64Music/stereo.mus", bufferMUS, sizeof(bufferMUS));
+    tar.file("C64Music/stereo.str", bufferMUS, sizeof(bufferMUS));
+    tar.end();
+    CHECK(tar.write());
+    CHECK(archive.open(TARFILE));
+
+    SidTune tune(nullptr);
+    tune.load(archive, "C64Music/mono.mus");
+    CHECK(tune.getStatus());
+    CHECK_EQUAL(1U, tune.getInfo()->sidChips());
+
+    // The companion STR file is looked up in the archive
+    tune.load(archive, "C64Music/stereo.mus");
+    CHECK(tune.getStatus());
+    CHECK_EQUAL(2U, tune.getInfo()->sidChips());
+
+    tune.load(archive, "C64Music/stereo.str");
+    CHECK(tune.getStatus());
+    CHECK_EQUAL(2U, tune.getInfo()->sidChips());
+}
+
+}
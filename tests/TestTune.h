@@ -0,0 +1,102 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+ * Helpers for the tests playing generated tunes.
+ */
+
+#ifndef TESTTUNE_H
+#define TESTTUNE_H
+
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/sidplayfp/sidbuilder.h"
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+
+/// Address of the init routine
+#define INIT_ADDR 0x1000
+
+/// Address of the play routine
+#define PLAY_ADDR 0x1020
+
+/**
+ * Build a PAL 6581 PSID with the given init and play routines,
+ * each of them ending with RTS, or just RTS if not given.
+ *
+ * @param init the init code, up to 32 bytes
+ * @param play the play code
+ * @param songs the number of songs
+ * @param sids the number of SIDs, the second one at $D420
+ *        and the third one at $D440
+ */
+inline std::vector<uint8_t> makeTune(const uint8_t *init, size_t initSize,
+                                     const uint8_t *play, size_t playSize,
+                                     unsigned int songs = 1, unsigned int sids = 1)
+{
+    std::vector<uint8_t> tune(0x7c, 0);
+    memcpy(&tune[0], "PSID", 4);
+    tune[5] = sids > 2 ? 4 : (sids > 1 ? 3 : 2); // version
+    tune[7] = 0x7c;                 // data offset
+    tune[10] = INIT_ADDR >> 8;      // init
+    tune[12] = PLAY_ADDR >> 8;      // play
+    tune[13] = PLAY_ADDR & 0xff;
+    tune[15] = songs;               // songs
+    tune[17] = 1;                   // start song
+    tune[119] = 0x14;               // PAL, 6581
+    if (sids > 1)
+        tune[122] = 0x42;           // second SID at $D420
+    if (sids > 2)
+        tune[123] = 0x44;           // third SID at $D440
+
+    // load address
+    tune.push_back(INIT_ADDR & 0xff);
+    tune.push_back(INIT_ADDR >> 8);
+
+    const uint8_t rts = 0x60;
+    std::vector<uint8_t> data(PLAY_ADDR - INIT_ADDR, rts);
+    if (init != nullptr)
+        memcpy(&data[0], init, initSize);
+
+    if (play != nullptr)
+        data.insert(data.end(), play, play + playSize);
+    else
+        data.push_back(rts);
+
+    tune.insert(tune.end(), data.begin(), data.end());
+
+    return tune;
+}
+
+/**
+ * Configuration for deterministic renderings at 44.1 kHz.
+ */
+inline SidConfig makeConfig(sidbuilder *builder)
+{
+    SidConfig cfg;
+    cfg.sidEmulation = builder;
+    cfg.frequency = 44100;
+    cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+    cfg.seed = 1;
+    return cfg;
+}
+
+#endif // TESTTUNE_H